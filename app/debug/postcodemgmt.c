@@ -10,6 +10,9 @@
 #include "espi_hub.h"
 #include "postcodemgmt.h"
 #include "port80display.h"
+#ifdef CONFIG_BOOT_PROFILER
+#include "boot_prof.h"
+#endif
 LOG_MODULE_REGISTER(postcode, CONFIG_POSTCODE_LOG_LEVEL);
 
 static struct k_sem update_lock;
@@ -54,6 +57,9 @@ static void update_postcode(uint8_t port_index, uint8_t code)
 
 	switch (port_index) {
 	case POSTCODE_PORT80:
+#ifdef CONFIG_BOOT_PROFILER
+		boot_prof_mark(BOOT_PROF_PORT80);
+#endif
 		if (port80_code != code) {
 			port80_code = code;
 			LOG_DBG("port80:%02x", code);
@@ -93,6 +93,27 @@ struct dtt_threshold {
 
 };
 
+/* DTT sensor event types */
+#define DTT_EVT_LOW_TRIP	0x1
+#define DTT_EVT_LOW_CLEAR	0x2
+#define DTT_EVT_HIGH_TRIP	0x3
+#define DTT_EVT_HIGH_CLEAR	0x4
+
+/**
+ * @brief Sensor trip status transition reported to host.
+ *
+ * Multi-byte fields are little endian.
+ */
+struct dtt_event {
+	/* EC uptime in milliseconds */
+	uint32_t timestamp;
+	/* Sensor index in acpi table */
+	uint8_t sensor;
+	uint8_t type;
+	/* Sensor temperature which caused the transition */
+	int16_t temp;
+} __packed;
+
 /**
  * @brief Initialize DTT thermals module
  *
@@ -116,10 +137,31 @@ void smc_update_dtt_threshold_limits(enum acpi_thrm_sens_idx acpi_sen_idx,
  *
  * This should be called from thermal management routine after getting updated
  * values for thermal sensors.
- * If sensor reading crosses any trip point, appropriate trip event will
- * be sent out to the host.
+ * Each sensor keeps the range in which its trip status cannot change, so a
+ * sample inside that range is discarded with a single compare. If sensor
+ * reading crosses any trip point, a timestamped event is queued and
+ * appropriate trip event will be sent out to the host.
  */
 void dtt_therm_sensor_trip(void);
+
+/**
+ * @brief Remove oldest sensor events from queue.
+ *
+ * @param evts buffer to copy events to.
+ * @param max maximum number of events to copy.
+ * @param overflow pointer to update number of events dropped since last
+ * call because queue was full.
+ *
+ * @retval number of events copied.
+ */
+uint8_t dtt_pop_events(struct dtt_event *evts, uint8_t max, uint8_t *overflow);
+
+/**
+ * @brief Number of sensor events waiting in queue.
+ *
+ * @retval number of events.
+ */
+uint8_t dtt_pending_events(void);
 #endif
 
 #endif /* __DTT_H_ */
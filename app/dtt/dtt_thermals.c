@@ -5,6 +5,7 @@
  */
 
 #include <zephyr.h>
+#include <sys/byteorder.h>
 #include <logging/log.h>
 #include "board_config.h"
 #include "smc.h"
@@ -16,6 +17,26 @@ LOG_MODULE_REGISTER(dtt_thrm, CONFIG_DTT_MODULE_LOG_LEVEL);
 static uint8_t *therm_sensors;
 static struct dtt_threshold dtt_sensor_trip_tbl[ACPI_THRM_SEN_TOTAL];
 
+/* Temperature range in which sensor trip status does not change */
+struct dtt_band {
+	int16_t lo;
+	/* hi - lo, sample is inside when (temp - lo) <= width as unsigned */
+	uint16_t width;
+};
+
+static struct dtt_band dtt_sensor_band[ACPI_THRM_SEN_TOTAL];
+
+struct dtt_event_queue {
+	struct dtt_event buf[CONFIG_DTT_EVENT_QUEUE_SIZE];
+	uint8_t head;
+	uint8_t count;
+	/* Events dropped since last host read */
+	uint8_t overflow;
+};
+
+static struct dtt_event_queue dtt_evq;
+static struct k_spinlock dtt_evq_lock;
+
 /**
  * DTT threshold default values upon init in degree celsius:
  * - low trip temp = 95c
@@ -32,6 +53,98 @@ static struct dtt_threshold dtt_sensor_trip_tbl[ACPI_THRM_SEN_TOTAL];
 #define DTT_THRSHLD_STATUS_BIT_LOW_TRIP		4u
 #define DTT_THRSHLD_STATUS_BIT_HIGH_TRIP	5u
 
+/* Empty band, forces evaluation of next sample */
+#define DTT_BAND_INVALID	((struct dtt_band){ .lo = INT16_MAX, .width = 0 })
+
+static void dtt_update_band(uint8_t idx)
+{
+	struct dtt_threshold *thrshld = &dtt_sensor_trip_tbl[idx];
+	int32_t lo = INT16_MIN;
+	int32_t hi = INT16_MAX;
+
+	/* Low trip status changes below low_temp or at low_temp + hyst */
+	if (thrshld->status & BIT(DTT_THRSHLD_STATUS_BIT_LOW_TRIP)) {
+		hi = MIN(hi, thrshld->low_temp + thrshld->temp_hyst - 1);
+	} else {
+		lo = MAX(lo, thrshld->low_temp);
+	}
+
+	/* High trip status changes above high_temp or at high_temp - hyst */
+	if (thrshld->status & BIT(DTT_THRSHLD_STATUS_BIT_HIGH_TRIP)) {
+		lo = MAX(lo, thrshld->high_temp - thrshld->temp_hyst + 1);
+	} else {
+		hi = MIN(hi, thrshld->high_temp);
+	}
+
+	if (lo > hi) {
+		dtt_sensor_band[idx] = DTT_BAND_INVALID;
+		return;
+	}
+
+	dtt_sensor_band[idx].lo = lo;
+	dtt_sensor_band[idx].width = hi - lo;
+}
+
+static inline bool dtt_in_band(uint8_t idx, int16_t temp)
+{
+	const struct dtt_band *band = &dtt_sensor_band[idx];
+
+	return (uint16_t)(temp - band->lo) <= band->width &&
+	       band->lo != INT16_MAX;
+}
+
+static void dtt_push_event(uint8_t idx, uint8_t type, int16_t temp)
+{
+	k_spinlock_key_t key = k_spin_lock(&dtt_evq_lock);
+	struct dtt_event *evt;
+	uint8_t tail;
+
+	if (dtt_evq.count == CONFIG_DTT_EVENT_QUEUE_SIZE) {
+		/* Keep most recent events, drop oldest */
+		dtt_evq.head = (dtt_evq.head + 1) % CONFIG_DTT_EVENT_QUEUE_SIZE;
+		dtt_evq.count--;
+		if (dtt_evq.overflow < UINT8_MAX) {
+			dtt_evq.overflow++;
+		}
+	}
+
+	tail = (dtt_evq.head + dtt_evq.count) % CONFIG_DTT_EVENT_QUEUE_SIZE;
+	evt = &dtt_evq.buf[tail];
+	evt->timestamp = sys_cpu_to_le32(k_uptime_get_32());
+	evt->sensor = idx;
+	evt->type = type;
+	evt->temp = sys_cpu_to_le16(temp);
+	dtt_evq.count++;
+
+	k_spin_unlock(&dtt_evq_lock, key);
+
+	LOG_INF("DTT sensor %d event %d temp %d", idx, type, temp);
+}
+
+uint8_t dtt_pop_events(struct dtt_event *evts, uint8_t max, uint8_t *overflow)
+{
+	k_spinlock_key_t key = k_spin_lock(&dtt_evq_lock);
+	uint8_t cnt = MIN(max, dtt_evq.count);
+
+	for (uint8_t i = 0; i < cnt; i++) {
+		evts[i] = dtt_evq.buf[dtt_evq.head];
+		dtt_evq.head = (dtt_evq.head + 1) % CONFIG_DTT_EVENT_QUEUE_SIZE;
+	}
+
+	dtt_evq.count -= cnt;
+	*overflow = dtt_evq.overflow;
+	dtt_evq.overflow = 0;
+
+	k_spin_unlock(&dtt_evq_lock, key);
+
+	return cnt;
+}
+
+uint8_t dtt_pending_events(void)
+{
+	return dtt_evq.count;
+}
+
 
 void dtt_init_thermals(uint8_t *therm_sensors_list)
 {
@@ -45,6 +158,7 @@ void dtt_init_thermals(uint8_t *therm_sensors_list)
 			thrshld->high_temp = DTT_HIGH_TRIP_DEFAULT;
 			thrshld->temp_hyst = DTT_TEMP_HYST_DEFAULT;
 			thrshld->status = BIT(DTT_THRSHLD_STATUS_BIT_INIT);
+			dtt_update_band(idx);
 		}
 	}
 }
@@ -67,6 +181,55 @@ void smc_update_dtt_threshold_limits(enum acpi_thrm_sens_idx acpi_sen_idx,
 	thrsh->high_temp = thrshld.high_temp;
 	thrsh->low_temp = thrshld.low_temp;
 	thrsh->temp_hyst = thrshld.temp_hyst;
+
+	/* Re-evaluate sensor against new limits on next sample */
+	dtt_sensor_band[acpi_sen_idx] = DTT_BAND_INVALID;
+}
+
+static void dtt_eval_trip(uint8_t idx, int16_t snstemp)
+{
+	struct dtt_threshold *thrshld = &dtt_sensor_trip_tbl[idx];
+	uint8_t old_status = thrshld->status;
+	uint8_t changed;
+	bool tripped;
+	int16_t triplimit;
+
+	/* Low temperature trip check */
+	tripped = thrshld->status & BIT(DTT_THRSHLD_STATUS_BIT_LOW_TRIP);
+	triplimit = (tripped ? (thrshld->low_temp + thrshld->temp_hyst) :
+		(thrshld->low_temp));
+
+	if (snstemp < triplimit) {
+		thrshld->status |= BIT(DTT_THRSHLD_STATUS_BIT_LOW_TRIP);
+	} else {
+		thrshld->status &= ~BIT(DTT_THRSHLD_STATUS_BIT_LOW_TRIP);
+	}
+
+	/* High temperature trip check */
+	tripped = thrshld->status & BIT(DTT_THRSHLD_STATUS_BIT_HIGH_TRIP);
+	triplimit = (tripped ? (thrshld->high_temp - thrshld->temp_hyst) :
+		(thrshld->high_temp));
+
+	if (snstemp > triplimit) {
+		thrshld->status |= BIT(DTT_THRSHLD_STATUS_BIT_HIGH_TRIP);
+	} else {
+		thrshld->status &= ~BIT(DTT_THRSHLD_STATUS_BIT_HIGH_TRIP);
+	}
+
+	changed = thrshld->status ^ old_status;
+	if (changed & BIT(DTT_THRSHLD_STATUS_BIT_LOW_TRIP)) {
+		dtt_push_event(idx, (thrshld->status &
+				     BIT(DTT_THRSHLD_STATUS_BIT_LOW_TRIP)) ?
+			       DTT_EVT_LOW_TRIP : DTT_EVT_LOW_CLEAR, snstemp);
+	}
+
+	if (changed & BIT(DTT_THRSHLD_STATUS_BIT_HIGH_TRIP)) {
+		dtt_push_event(idx, (thrshld->status &
+				     BIT(DTT_THRSHLD_STATUS_BIT_HIGH_TRIP)) ?
+			       DTT_EVT_HIGH_TRIP : DTT_EVT_HIGH_CLEAR, snstemp);
+	}
+
+	dtt_update_band(idx);
 }
 
 void dtt_therm_sensor_trip(void)
@@ -75,41 +238,26 @@ void dtt_therm_sensor_trip(void)
 
 	for (uint8_t idx = 0; idx < ACPI_THRM_SEN_TOTAL; idx++) {
 		struct dtt_threshold *thrshld = &dtt_sensor_trip_tbl[idx];
-		int16_t snstemp = adc_temp_val[therm_sensors[idx]];
-		bool tripped;
-		int16_t triplimit;
+		int16_t snstemp;
 		uint8_t old_status = thrshld->status;
 
-		if (!(dtt_sensor_trip_tbl[idx].status & BIT(DTT_THRSHLD_STATUS_BIT_INIT))) {
+		if (!(thrshld->status & BIT(DTT_THRSHLD_STATUS_BIT_INIT))) {
 			continue;
 		}
 
-		/* Low temperature trip check */
-		tripped = thrshld->status & BIT(DTT_THRSHLD_STATUS_BIT_LOW_TRIP);
-		triplimit = (tripped ? (thrshld->low_temp + thrshld->temp_hyst) :
-			(thrshld->low_temp));
-
-		if (snstemp < triplimit) {
-			thrshld->status |= BIT(DTT_THRSHLD_STATUS_BIT_LOW_TRIP);
-		} else {
-			thrshld->status &= ~BIT(DTT_THRSHLD_STATUS_BIT_LOW_TRIP);
-		}
-
-		/* High temperature trip check */
-		tripped = thrshld->status & BIT(DTT_THRSHLD_STATUS_BIT_HIGH_TRIP);
-		triplimit = (tripped ? (thrshld->high_temp - thrshld->temp_hyst) :
-			(thrshld->high_temp));
-
-		if (snstemp > triplimit) {
-			thrshld->status |= BIT(DTT_THRSHLD_STATUS_BIT_HIGH_TRIP);
-		} else {
-			thrshld->status &= ~BIT(DTT_THRSHLD_STATUS_BIT_HIGH_TRIP);
+		snstemp = adc_temp_val[therm_sensors[idx]];
+		if (dtt_in_band(idx, snstemp)) {
+			continue;
 		}
 
+		dtt_eval_trip(idx, snstemp);
 		if (thrshld->status ^ old_status) {
 			acpi_thrm_stat |= BIT(idx);
 		}
 	}
 
-	smc_update_therm_trip_status(acpi_thrm_stat);
+	/* Status and SCI are only updated on actual transitions */
+	if (acpi_thrm_stat) {
+		smc_update_therm_trip_status(acpi_thrm_stat);
+	}
 }
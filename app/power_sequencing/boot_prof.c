@@ -0,0 +1,177 @@
+/*
+ * Copyright (c) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr.h>
+#include <logging/log.h>
+#include "system.h"
+#include "memops.h"
+#include "pwrplane.h"
+#include "pwrseq_steps.h"
+#include "boot_prof.h"
+#ifdef CONFIG_PERIPHERAL_MANAGEMENT
+#include "pwrbtnmgmt.h"
+#endif
+
+LOG_MODULE_DECLARE(pwrmgmt, CONFIG_PWRMGT_LOG_LEVEL);
+
+#define BOOT_PROF_MAGIC		0x5042u
+
+/* Record outside of zero initialized RAM to keep it across EC reset */
+static struct boot_prof_rec rec __noinit;
+static struct k_spinlock lock;
+static uint32_t start_cyc;
+static int64_t start_ticks;
+
+static void rec_start(uint8_t type)
+{
+	uint8_t i;
+
+	rec.type = type;
+	rec.state = BOOT_PROF_ST_ACTIVE;
+	rec.count++;
+	for (i = 0; i < BOOT_PROF_NUM_MARKS; i++) {
+		rec.ts[i] = BOOT_PROF_NO_TS;
+	}
+
+	start_cyc = k_cycle_get_32();
+	start_ticks = k_uptime_ticks();
+}
+
+/* Time elapsed since start of record in us, saturated below BOOT_PROF_NO_TS */
+static uint32_t rec_elapsed_us(uint32_t now_cyc, int64_t now_ticks)
+{
+	uint64_t us = k_ticks_to_us_floor64(now_ticks - start_ticks);
+
+	/* 32-bit cycle counter wraps, e.g. after ~89 s at 48 MHz. Events
+	 * that far from start of record use coarser kernel ticks instead.
+	 */
+	if (us >= k_cyc_to_us_floor64(INT32_MAX)) {
+		return MIN(us, BOOT_PROF_NO_TS - 1);
+	}
+
+	return k_cyc_to_us_floor32(now_cyc - start_cyc);
+}
+
+static uint8_t slp_type(uint8_t mark)
+{
+	switch (mark) {
+	case BOOT_PROF_SLP_S5:
+	case BOOT_PROF_SLP_S4:
+		return BOOT_PROF_TYPE_S5_S0;
+	case BOOT_PROF_SLP_S3:
+		return BOOT_PROF_TYPE_S3_S0;
+	default:
+		return BOOT_PROF_TYPE_NONE;
+	}
+}
+
+#ifdef CONFIG_PERIPHERAL_MANAGEMENT
+static void boot_prof_pwrbtn_handler(uint8_t pwrbtn_sts)
+{
+	enum system_power_state state = pwrseq_system_state();
+
+	/* Power button is active low, only a press from Sx starts a boot */
+	if (pwrbtn_sts || state == SYSTEM_S0_STATE) {
+		return;
+	}
+
+	boot_prof_start(state == SYSTEM_S3_STATE ? BOOT_PROF_TYPE_S3_S0 :
+			BOOT_PROF_TYPE_S5_S0);
+	boot_prof_mark(BOOT_PROF_PWRBTN);
+}
+#endif
+
+void boot_prof_init(void)
+{
+	if (rec.magic != BOOT_PROF_MAGIC) {
+		memsets(&rec, 0, sizeof(rec));
+		rec.magic = BOOT_PROF_MAGIC;
+	}
+
+	/* Profile interrupted by EC reset cannot be completed */
+	if (rec.state == BOOT_PROF_ST_ACTIVE) {
+		rec.state = BOOT_PROF_ST_FAILED;
+	}
+
+	rec.poll_us = PWRSEQ_POLL_PERIOD_US;
+
+#ifdef CONFIG_PERIPHERAL_MANAGEMENT
+	pwrbtn_register_handler(boot_prof_pwrbtn_handler);
+#endif
+}
+
+void boot_prof_start(uint8_t type)
+{
+	k_spinlock_key_t key = k_spin_lock(&lock);
+
+	rec_start(type);
+	k_spin_unlock(&lock, key);
+}
+
+void boot_prof_set_type(uint8_t type)
+{
+	k_spinlock_key_t key = k_spin_lock(&lock);
+
+	if (rec.state == BOOT_PROF_ST_ACTIVE) {
+		rec.type = type;
+	}
+
+	k_spin_unlock(&lock, key);
+}
+
+void boot_prof_mark(uint8_t mark)
+{
+	k_spinlock_key_t key;
+	uint32_t now = k_cycle_get_32();
+	int64_t now_ticks = k_uptime_ticks();
+
+	if (mark == BOOT_PROF_NONE || mark >= BOOT_PROF_MARKS) {
+		return;
+	}
+
+	key = k_spin_lock(&lock);
+
+	/* Wake events other than power button start at SLP_Sx de-assertion */
+	if (rec.state != BOOT_PROF_ST_ACTIVE &&
+	    slp_type(mark) != BOOT_PROF_TYPE_NONE) {
+		rec_start(slp_type(mark));
+		now = start_cyc;
+		now_ticks = start_ticks;
+	}
+
+	/* Only first BIOS postcode is expected after power on completes */
+	if ((rec.state == BOOT_PROF_ST_ACTIVE ||
+	     (rec.state == BOOT_PROF_ST_DONE && mark == BOOT_PROF_PORT80)) &&
+	    rec.ts[mark - 1] == BOOT_PROF_NO_TS) {
+		rec.ts[mark - 1] = rec_elapsed_us(now, now_ticks);
+	}
+
+	k_spin_unlock(&lock, key);
+}
+
+void boot_prof_end(int result)
+{
+	k_spinlock_key_t key = k_spin_lock(&lock);
+
+	if (rec.state == BOOT_PROF_ST_ACTIVE) {
+		rec.ts[BOOT_PROF_PWRSEQ_END - 1] =
+			rec_elapsed_us(k_cycle_get_32(), k_uptime_ticks());
+		rec.state = result ? BOOT_PROF_ST_FAILED : BOOT_PROF_ST_DONE;
+	}
+
+	k_spin_unlock(&lock, key);
+
+	LOG_INF("Boot profile %d: %d us", rec.type,
+		rec.ts[BOOT_PROF_PWRSEQ_END - 1]);
+}
+
+void boot_prof_get(struct boot_prof_rec *out)
+{
+	k_spinlock_key_t key = k_spin_lock(&lock);
+
+	memcpys(out, &rec, sizeof(rec));
+	k_spin_unlock(&lock, key);
+}
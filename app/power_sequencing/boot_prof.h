@@ -0,0 +1,129 @@
+/*
+ * Copyright (c) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef __BOOT_PROF_H__
+#define __BOOT_PROF_H__
+
+#include <zephyr.h>
+
+/**
+ * @brief Power sequence events timestamped by boot profiler.
+ *
+ * Order matches expected order of events during S5->S0 transition.
+ */
+enum boot_prof_mark {
+	BOOT_PROF_NONE,
+	/* Power button press, also start of record if present */
+	BOOT_PROF_PWRBTN,
+	/* SLP_Sx virtual wires de-assertion as notified by eSPI */
+	BOOT_PROF_SLP_S5,
+	BOOT_PROF_SLP_S4,
+	BOOT_PROF_SLP_S3,
+	/* Power sequencing task starts power on sequence */
+	BOOT_PROF_PWRSEQ_START,
+	BOOT_PROF_RSMRST_PWRGD,
+	BOOT_PROF_PM_RSMRST,
+	BOOT_PROF_SLP_A,
+	BOOT_PROF_ALL_SYS_PWRGD,
+	BOOT_PROF_PCH_PWROK,
+	BOOT_PROF_SYS_PWROK,
+	BOOT_PROF_PLTRST,
+	/* Power on sequence completed */
+	BOOT_PROF_PWRSEQ_END,
+	/* First BIOS postcode received */
+	BOOT_PROF_PORT80,
+	BOOT_PROF_MARKS,
+};
+
+/* Number of timestamps in a record, BOOT_PROF_NONE is not recorded */
+#define BOOT_PROF_NUM_MARKS	(BOOT_PROF_MARKS - 1)
+
+/* Timestamp of an event which did not occur */
+#define BOOT_PROF_NO_TS		UINT32_MAX
+
+/* Boot profile transition types */
+#define BOOT_PROF_TYPE_NONE	0
+#define BOOT_PROF_TYPE_S5_S0	1
+#define BOOT_PROF_TYPE_S3_S0	2
+/* S3->S0 using preconditions validated at S3 entry */
+#define BOOT_PROF_TYPE_S3_S0_FAST	3
+
+/* Boot profile record states */
+#define BOOT_PROF_ST_IDLE	0
+#define BOOT_PROF_ST_ACTIVE	1
+#define BOOT_PROF_ST_DONE	2
+#define BOOT_PROF_ST_FAILED	3
+
+/**
+ * @brief Boot profile record.
+ *
+ * Timestamps are in us relative to the first event in the record. Events
+ * later than half the cycle counter wrap period, e.g. ~44 s at 48 MHz, use
+ * kernel tick resolution. Record is kept in RAM which is not initialized at
+ * EC boot, so the last profile survives EC reset.
+ */
+struct boot_prof_rec {
+	uint16_t magic;
+	uint8_t type;
+	uint8_t state;
+	/* Number of power sequence transitions profiled since power loss */
+	uint16_t count;
+	/* Granularity of power sequence signal polling in us */
+	uint16_t poll_us;
+	uint32_t ts[BOOT_PROF_NUM_MARKS];
+};
+
+/**
+ * @brief Initialize boot profiler.
+ *
+ * Keeps record from previous EC boot if valid.
+ */
+void boot_prof_init(void);
+
+/**
+ * @brief Start a new boot profile record.
+ *
+ * Any profile in progress is discarded.
+ *
+ * @param type transition type, see BOOT_PROF_TYPE_*.
+ */
+void boot_prof_start(uint8_t type);
+
+/**
+ * @brief Update transition type of the boot profile in progress.
+ *
+ * @param type transition type, see BOOT_PROF_TYPE_*.
+ */
+void boot_prof_set_type(uint8_t type);
+
+/**
+ * @brief Timestamp a power sequence event.
+ *
+ * Only first occurrence of every event is recorded. SLP_Sx events start a
+ * record if none is in progress, e.g. for wake events other than power
+ * button. Safe to call from interrupt context.
+ *
+ * @param mark power sequence event.
+ */
+void boot_prof_mark(uint8_t mark);
+
+/**
+ * @brief Complete power on sequence profile.
+ *
+ * Record remains open to timestamp first BIOS postcode.
+ *
+ * @param result power on sequence result.
+ */
+void boot_prof_end(int result);
+
+/**
+ * @brief Get a copy of the current boot profile record.
+ *
+ * @param rec buffer for record.
+ */
+void boot_prof_get(struct boot_prof_rec *rec);
+
+#endif /* __BOOT_PROF_H__ */
@@ -9,6 +9,9 @@
 #include "eeprom.h"
 #include "errcodes.h"
 #include "dswmode.h"
+#ifdef CONFIG_PWRSEQ_EVENT_DRIVEN_TASK
+#include "pwrplane.h"
+#endif
 #include <logging/log.h>
 LOG_MODULE_DECLARE(pwrmgmt, CONFIG_PWRMGT_LOG_LEVEL);
 
@@ -47,6 +50,10 @@ void dsw_update_mode(uint8_t mode)
 
 	dsw_tmp_config = mode;
 	dsw_mode_update = true;
+#ifdef CONFIG_PWRSEQ_EVENT_DRIVEN_TASK
+	/* EEPROM update is done by power sequencing task */
+	pwrseq_signal_request();
+#endif
 }
 
 void dsw_read_mode(void)
@@ -111,6 +111,9 @@ static void counter_expired_hndlr(struct k_timer *counter)
 		} else {
 			pg3_generate_wake = true;
 			LOG_DBG("Generate PG3 wake");
+#ifdef CONFIG_PWRSEQ_EVENT_DRIVEN_TASK
+			pwrseq_signal_request();
+#endif
 		}
 	}
 }
@@ -120,6 +123,10 @@ static void pseudo_g3_set_state(uint8_t next_state)
 	LOG_DBG("Moving to PG3 state:%d", next_state);
 	pg3_prev_state = pg3_state;
 	pg3_state = next_state;
+#ifdef CONFIG_PWRSEQ_EVENT_DRIVEN_TASK
+	/* Let new state be evaluated without waiting for another event */
+	pwrseq_signal_request();
+#endif
 }
 
 void pseudo_g3_program_counter(enum pg3_counter counter, uint32_t count)
@@ -297,6 +304,9 @@ void pseudo_g3_enable(bool status)
 {
 	pg3_enable_status = status;
 	LOG_DBG("pg3_enable_status:%d", status);
+#ifdef CONFIG_PWRSEQ_EVENT_DRIVEN_TASK
+	pwrseq_signal_request();
+#endif
 }
 
 bool pseudo_g3_get_state(void)
@@ -309,6 +319,12 @@ bool pseudo_g3_get_prev_state(void)
 	return (pg3_prev_state == PG3_STATE_ENTERED);
 }
 
+bool pseudo_g3_poll_required(void)
+{
+	/* SUS_PWRDN_ACK virtual wire change is not notified */
+	return (pg3_state == PG3_STATE_WAITING_ENTRY);
+}
+
 void manage_pseudog3(void)
 {
 	manage_pseudog3_states();
@@ -37,6 +37,13 @@ bool pseudo_g3_get_state(void);
  */
 bool pseudo_g3_get_prev_state(void);
 
+/**
+ * @brief Indicate if Pseudo G3 entry conditions need to be polled.
+ *
+ * @return true if waiting for Pseudo G3 entry otherwise false.
+ */
+bool pseudo_g3_poll_required(void);
+
 /**
  * @brief Program counter value for respective Pseudo G3 counter.
  *
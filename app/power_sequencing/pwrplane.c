@@ -31,6 +31,7 @@
 #include "soc_debug.h"
 #endif
 #include "pwrseq_timeouts.h"
+#include "pwrseq_steps.h"
 #include "errcodes.h"
 #ifdef CONFIG_SOC_FAMILY_MEC
 #include "vci.h"
@@ -43,23 +44,23 @@
 #ifdef CONFIG_DNX_SUPPORT
 #include "dnx.h"
 #endif
+#ifdef CONFIG_THERMAL_HISTORY
+#include "therm_hist.h"
+#endif
+#ifdef CONFIG_BOOT_PROFILER
+#include "boot_prof.h"
+#endif
+#ifdef CONFIG_PWRSEQ_JOURNAL
+#include "pwrseq_journal.h"
+#endif
 
 LOG_MODULE_REGISTER(pwrmgmt, CONFIG_PWRMGT_LOG_LEVEL);
 
 /* For more details for below signals refer to platform design guidelines
  * If not explicitly indicated delays are in miliseconds.
+ * Power on/off signal timing is described in pwrseq_tables.c.
  */
 
-/* VCCST_PWRGD & PM_PCH_PWROK to be generated together 2ms after
- * ALL_SYS_PWRGD
- */
-#define VR_ON_RAMP_DELAY_US    2000U
-
-#define PM_PWROFF_DELAY_US     500U
-
-/* PCH_PWROK to be generated T36 = 99 ms after SYS_PWROK */
-#define SYS_PWR_OK_DELAY       99U
-
 /* PM_RSMRST_ should be released 200 ms after PM_RSMRST_PWRGD */
 #define PM_RSMRST_DELAY        200U
 
@@ -76,6 +77,10 @@ struct pwr_flags g_pwrflags;
 static bool pwrseq_timeout_disabled;
 static bool pwrseq_failure;
 static bool in_therm_shutdown;
+#ifdef CONFIG_POWER_SEQUENCE_FAST_S3_RESUME
+/* Power on preconditions were validated at S3 entry */
+static bool s3_resume_ready;
+#endif
 
 /* System state machine */
 static enum system_power_state current_state;
@@ -101,6 +106,12 @@ uint8_t read_shutdown_reason(void)
 void set_shutdown_reason(uint8_t reason)
 {
 	shutdown_reason = reason;
+#ifdef CONFIG_PWRSEQ_JOURNAL
+	/* Host clears the reason once read, nothing to record */
+	if (reason != SHUTDOWN_REASON_DEFAULT) {
+		pwrseq_journal_record(PWRSEQ_JOURNAL_SHUTDOWN, reason, 0);
+	}
+#endif
 }
 
 enum system_power_state pwrseq_system_state(void)
@@ -137,10 +148,129 @@ void ec_evaluate_timeout(void)
 	}
 }
 
+#ifdef CONFIG_PWRSEQ_EVENT_DRIVEN_TASK
+/* Trigger from signal changes or state change requests generated by
+ * other EC FW modules.
+ */
+K_SEM_DEFINE(pwrseq_lock, 0, 1);
+
+/* Fallback wake up while DeepSx entry is pending, eSPI reset de-assertion
+ * is not notified to power sequencing.
+ */
+#define PWRSEQ_DSX_RECHECK_MS	1000
+
+/* RSMRST_PWRGD, BC_ACOK, PM_SLP_SUS and ATX_DETECT */
+#define PWRSEQ_EVENT_PINS	4
+
+static struct gpio_callback pwrseq_pin_cb[PWRSEQ_EVENT_PINS];
+
+void pwrseq_signal_request(void)
+{
+	k_sem_give(&pwrseq_lock);
+}
+
+static void pwrseq_pin_handler(const struct device *dev,
+			       struct gpio_callback *gpio_cb, uint32_t pins)
+{
+	pwrseq_signal_request();
+}
+
+static void pwrseq_monitor_pin(uint8_t idx, uint32_t port_pin)
+{
+	int ret;
+
+	ret = gpio_init_callback_pin(port_pin, &pwrseq_pin_cb[idx],
+				     pwrseq_pin_handler);
+	if (ret) {
+		LOG_ERR("Failed to init callback for %x",
+			gpio_get_pin(port_pin));
+		return;
+	}
+
+	ret = gpio_add_callback_pin(port_pin, &pwrseq_pin_cb[idx]);
+	if (ret) {
+		LOG_ERR("Failed to add callback for %x",
+			gpio_get_pin(port_pin));
+		return;
+	}
+
+	ret = gpio_interrupt_configure_pin(port_pin, GPIO_INT_EDGE_BOTH);
+	if (ret) {
+		LOG_ERR("Failed to configure isr for %x",
+			gpio_get_pin(port_pin));
+	}
+}
+
+static void pwrseq_monitor_events(void)
+{
+	uint8_t idx = 0;
+
+	pwrseq_monitor_pin(idx++, RSMRST_PWRGD);
+	pwrseq_monitor_pin(idx++, BC_ACOK);
+#ifdef CONFIG_PWRMGMT_DEEPSX
+	/* DeepSx exit */
+	pwrseq_monitor_pin(idx++, PM_SLP_SUS);
+#endif
+#ifdef CONFIG_ATX_SUPPORT
+	pwrseq_monitor_pin(idx++, ATX_DETECT);
+#endif
+}
+
+static k_timeout_t pwrseq_next_wakeup(uint32_t period)
+{
+	enum system_power_state state = pwrseq_system_state();
+
+	/* Pseudo G3 entry depends on SUS_PWRDN_ACK virtual wire */
+	if (pseudo_g3_poll_required()) {
+		return K_MSEC(period);
+	}
+
+	/* DeepSx entry is triggered by SLP_A, SUS_WARN and power adapter
+	 * notifications.
+	 */
+	if (dsw_enabled() && !dsx_entered() &&
+	    (state == SYSTEM_S4_STATE || state == SYSTEM_S5_STATE)) {
+		return K_MSEC(PWRSEQ_DSX_RECHECK_MS);
+	}
+
+	return K_FOREVER;
+}
+#endif
+
+#ifdef CONFIG_BOOT_PROFILER
+static void pwrseq_prof_slp(uint32_t signal)
+{
+	switch (signal) {
+	case ESPI_VWIRE_SIGNAL_SLP_S5:
+		boot_prof_mark(BOOT_PROF_SLP_S5);
+		break;
+	case ESPI_VWIRE_SIGNAL_SLP_S4:
+		boot_prof_mark(BOOT_PROF_SLP_S4);
+		break;
+	case ESPI_VWIRE_SIGNAL_SLP_S3:
+		boot_prof_mark(BOOT_PROF_SLP_S3);
+		break;
+	default:
+		break;
+	}
+}
+#endif
+
 static void pwrseq_slp_handler(uint32_t signal, uint32_t status)
 {
+	/* SLP_A only gates DeepSx entry, see manage_deep_s4s5() */
+	if (signal == ESPI_VWIRE_SIGNAL_SLP_A) {
+#ifdef CONFIG_PWRSEQ_EVENT_DRIVEN_TASK
+		pwrseq_signal_request();
+#endif
+		return;
+	}
+
 	/* De-assert always indicates transition to S0 */
 	if (status) {
+#ifdef CONFIG_BOOT_PROFILER
+		pwrseq_prof_slp(signal);
+#endif
 		switch (current_state) {
 		case SYSTEM_S5_STATE:
 		case SYSTEM_S4_STATE:
@@ -181,6 +311,10 @@ static void pwrseq_slp_handler(uint32_t signal, uint32_t status)
 			break;
 		}
 	}
+
+#ifdef CONFIG_PWRSEQ_EVENT_DRIVEN_TASK
+	pwrseq_signal_request();
+#endif
 }
 
 static void pwrseq_sus_handler(uint8_t status)
@@ -190,6 +324,11 @@ static void pwrseq_sus_handler(uint8_t status)
 		LOG_DBG("Send ACK SUS WARN %d", status);
 		espihub_send_vw(ESPI_VWIRE_SIGNAL_SUS_ACK, status);
 	}
+
+#ifdef CONFIG_PWRSEQ_EVENT_DRIVEN_TASK
+	/* DeepSx entry waits for SUS_WARN */
+	pwrseq_signal_request();
+#endif
 }
 
 static void handle_spi_sharing(uint8_t boot_mode)
@@ -216,59 +355,6 @@ static void handle_spi_sharing(uint8_t boot_mode)
 	}
 }
 
-static int wait_for_pin_level(uint32_t port_pin, uint16_t timeout,
-			uint32_t exp_level)
-{
-	uint16_t loop_cnt = timeout;
-	int level;
-
-	do {
-		/* Passes the enconded gpio(port_pin) to the gpio driver */
-		level = gpio_read_pin(port_pin);
-		if (level < 0) {
-			LOG_ERR("Failed to read %x ", gpio_get_pin(port_pin));
-			return -EIO;
-		}
-
-		if (exp_level == level) {
-			LOG_DBG("Pin [%o]: %x",
-				get_absolute_gpio_num(port_pin), exp_level);
-			break;
-		}
-
-		k_usleep(100);
-		loop_cnt--;
-	} while (loop_cnt > 0 || (timeout == PWR_SEQ_TIMEOUT_FOREVER) ||
-		ec_timeout_status());
-
-	if (loop_cnt == 0) {
-		LOG_DBG("Timeout [%x]: %x", gpio_get_pin(port_pin), level);
-		return -ETIMEDOUT;
-	}
-
-	return 0;
-}
-
-static inline int wait_for_pin(uint32_t port_pin, uint16_t timeout,
-			       uint32_t exp_level)
-{
-	if (pwrseq_timeout_disabled) {
-		timeout = PWR_SEQ_TIMEOUT_FOREVER;
-	}
-
-	return wait_for_pin_level(port_pin, timeout, exp_level);
-}
-
-static inline int wait_for_vwire(uint8_t signal, uint16_t timeout,
-				uint8_t exp_level, bool ack_req)
-{
-	if (pwrseq_timeout_disabled) {
-		timeout = PWR_SEQ_TIMEOUT_FOREVER;
-	}
-
-	return espihub_wait_for_vwire(signal, timeout, exp_level, ack_req);
-}
-
 static inline int wait_for_espi_reset(uint8_t exp_sts, uint16_t timeout)
 {
 	if (pwrseq_timeout_disabled) {
@@ -280,33 +366,7 @@ static inline int wait_for_espi_reset(uint8_t exp_sts, uint16_t timeout)
 
 static int check_slp_signals(void)
 {
-	int ret;
-
-	/* Check for SLPS5#, SLPS4#, SLPS3# signals */
-	ret = wait_for_vwire(ESPI_VWIRE_SIGNAL_SLP_S5,
-			     TIMEOUT_TO_US(sw_strps()->timeouts.slp_s5),
-			     ESPIHUB_VW_HIGH, false);
-	if (ret) {
-		pwrseq_error(ERR_PM_SLPS5);
-		return ret;
-	}
-
-	ret = wait_for_vwire(ESPI_VWIRE_SIGNAL_SLP_S4,
-			     TIMEOUT_TO_US(sw_strps()->timeouts.slp_s4),
-			     ESPIHUB_VW_HIGH, false);
-	if (ret) {
-		pwrseq_error(ERR_PM_SLPS4);
-		return ret;
-	}
-
-	ret = wait_for_vwire(ESPI_VWIRE_SIGNAL_SLP_S3, SLPS3_TIMEOUT,
-			     ESPIHUB_VW_HIGH, false);
-	if (ret) {
-		pwrseq_error(ERR_PM_SLPS3);
-		return ret;
-	}
-
-	return 0;
+	return pwrseq_run(&pwrseq_slp_check);
 }
 
 void pwrseq_error(uint8_t error_code)
@@ -314,6 +374,9 @@ void pwrseq_error(uint8_t error_code)
 	LOG_ERR("%s: %d", __func__, error_code);
 
 	pwrseq_failure = true;
+#ifdef CONFIG_PWRSEQ_JOURNAL
+	pwrseq_journal_record(PWRSEQ_JOURNAL_ERROR, error_code, 0);
+#endif
 #ifdef CONFIG_POSTCODE_MANAGEMENT
 	update_error(error_code);
 #endif
@@ -347,6 +410,13 @@ static inline int pwrseq_task_init(void)
 	dnx_ec_assisted_init();
 #endif
 
+#ifdef CONFIG_BOOT_PROFILER
+	boot_prof_init();
+#endif
+#ifdef CONFIG_PWRSEQ_JOURNAL
+	pwrseq_journal_init();
+#endif
+
 	/* the charger type as of now is updated with a static value */
 	g_acpi_tbl.acpi_ctype_value = CTYPE_NVDC;
 
@@ -374,8 +444,8 @@ static inline int pwrseq_task_init(void)
 	vci_disable();
 	#endif
 
-	ret = wait_for_pin(RSMRST_PWRGD,
-			   RSMRST_PWRDG_TIMEOUT, 1);
+	ret = pwrseq_wait_pin(RSMRST_PWRGD,
+			      RSMRST_PWRDG_TIMEOUT, 1);
 	if (ret) {
 		pwrseq_error(ERR_RSMRST_PWRGD);
 		return ret;
@@ -388,9 +458,9 @@ static inline int pwrseq_task_init(void)
 		 * pin is in alt mode 1(ESPI_RST#). Bear in mind this is may
 		 * not be portable across SOCs.
 		 */
-		ret = wait_for_pin(ESPI_RESET_MAF,
-				   TIMEOUT_TO_US(sw_strps()->timeouts.espi_rst),
-				   1);
+		ret = pwrseq_wait_pin(ESPI_RESET_MAF,
+				      TIMEOUT_TO_US(sw_strps()->timeouts.espi_rst),
+				      1);
 		if (ret) {
 			pwrseq_error(ERR_ESPIRESET);
 			return ret;
@@ -425,7 +495,7 @@ static inline int pwrseq_task_init(void)
 
 #ifndef CONFIG_ESPI_AUTOMATIC_WARNING_ACKNOWLEDGE
 	/* This function performs when required SUS_ACK */
-	ret = wait_for_vwire(ESPI_VWIRE_SIGNAL_SUS_WARN,
+	ret = pwrseq_wait_vwire(ESPI_VWIRE_SIGNAL_SUS_WARN,
 			TIMEOUT_TO_US(sw_strps()->timeouts.sus_wrn),
 			ESPIHUB_VW_HIGH, true);
 	/* Only perform SUS_WRN timeout if DSx is enabled */
@@ -569,6 +639,10 @@ static void pwrseq_update(void)
 
 	if (valid_sx_transition) {
 		LOG_INF("System transition %d->%d", current_state, next_state);
+#ifdef CONFIG_PWRSEQ_JOURNAL
+		pwrseq_journal_record(PWRSEQ_JOURNAL_TRANSITION, current_state,
+				      next_state);
+#endif
 		current_state = next_state;
 	} else {
 		LOG_ERR("Unsupported next state: %d", next_state);
@@ -617,6 +691,9 @@ static void pwrpln_check_power_critical_levels(void)
 void set_next_state_to_S5(void)
 {
 	next_state = SYSTEM_S5_STATE;
+#ifdef CONFIG_PWRSEQ_EVENT_DRIVEN_TASK
+	pwrseq_signal_request();
+#endif
 }
 
 void pwrseq_thread(void *p1, void *p2, void *p3)
@@ -626,9 +703,17 @@ void pwrseq_thread(void *p1, void *p2, void *p3)
 
 	pwrseq_task_init();
 	dsw_read_mode();
+#ifdef CONFIG_PWRSEQ_EVENT_DRIVEN_TASK
+	pwrseq_monitor_events();
+#endif
 
 	while (true) {
+#ifdef CONFIG_PWRSEQ_EVENT_DRIVEN_TASK
+		/* Sleep until next event unless a condition needs polling */
+		k_sem_take(&pwrseq_lock, pwrseq_next_wakeup(period));
+#else
 		k_msleep(period);
+#endif
 
 		rsmrst_level = gpio_read_pin(RSMRST_PWRGD);
 
@@ -733,6 +818,15 @@ void therm_shutdown(void)
 	/* Sleep for 100ms as pwr_seq state machine needs to move S5 state */
 	k_msleep(PWR_PLANE_RSMRST_DELAY_MS);
 
+#ifdef CONFIG_THERMAL_HISTORY
+	/* Keep thermal trend leading to shutdown across power loss */
+	therm_hist_save();
+#endif
+#ifdef CONFIG_PWRSEQ_JOURNAL
+	/* Work queue may not get to run before power is lost */
+	pwrseq_journal_flush();
+#endif
+
 	/* System is moved to S5 state and SX state machine also updated.
 	 * Now suspend all the tasks
 	 */
@@ -741,6 +835,9 @@ void therm_shutdown(void)
 	while (true) {
 		if (gpio_read_pin(PWRBTN_EC_IN_N) == LOW) {
 			g_pwrflags.turn_pwr_on = true;
+#ifdef CONFIG_PWRSEQ_EVENT_DRIVEN_TASK
+			pwrseq_signal_request();
+#endif
 			/* Rotate fan and toggle leds until pwr btn pressed */
 			break;
 		}
@@ -769,13 +866,7 @@ static void power_off(void)
 {
 	int level;
 
-#ifdef VCCST_PWRGD
-	gpio_write_pin(VCCST_PWRGD, 0);
-#endif
-	gpio_write_pin(SYS_PWROK, 0);
-	gpio_write_pin(PCH_PWROK, 0);
-
-	k_busy_wait(PM_PWROFF_DELAY_US);
+	pwrseq_run(&pwrseq_power_off);
 
 	g_pwrflags.pwr_sw_enabled = 1;
 
@@ -803,12 +894,15 @@ static void power_off(void)
 }
 
 
-static int power_on(void)
+static int power_on_sequence(void)
 {
 	int ret;
 
 	LOG_INF("%s", __func__);
 
+#ifdef CONFIG_BOOT_PROFILER
+	boot_prof_mark(BOOT_PROF_PWRSEQ_START);
+#endif
 	pwrseq_reset();
 
 #ifdef CONFIG_SOC_DEBUG_AWARENESS
@@ -817,107 +911,142 @@ static int power_on(void)
 #ifdef CONFIG_DNX_EC_ASSISTED_TRIGGER
 	dnx_ec_assisted_manage();
 #endif
-	ret = wait_for_pin(RSMRST_PWRGD,
-			   RSMRST_PWRDG_TIMEOUT, 1);
+	ret = pwrseq_wait_pin(RSMRST_PWRGD, RSMRST_PWRDG_TIMEOUT, 1);
 	if (ret) {
 		LOG_ERR("RSMRST_PWRGD timeout");
 		pwrseq_error(ERR_RSMRST_PWRGD);
 		return ret;
 	}
+#ifdef CONFIG_BOOT_PROFILER
+	boot_prof_mark(BOOT_PROF_RSMRST_PWRGD);
+#endif
 
 	ret = gpio_write_pin(PM_RSMRST, 1);
 	if (ret) {
 		LOG_ERR("Unable to initialize %d ", gpio_get_pin(PM_RSMRST));
 		return ret;
 	}
+#ifdef CONFIG_BOOT_PROFILER
+	boot_prof_mark(BOOT_PROF_PM_RSMRST);
+#endif
 
 #ifdef CONFIG_POSTCODE_MANAGEMENT
 	port80_display_on();
 #endif
 
-	/* Check for SLPS5#, SLPS4#, SLPS3# signals */
-	ret = check_slp_signals();
+	ret = pwrseq_run(&pwrseq_power_on);
 	if (ret) {
 		return ret;
 	}
 
-	ret = wait_for_vwire(ESPI_VWIRE_SIGNAL_SLP_A,
-			     TIMEOUT_TO_US(sw_strps()->timeouts.slp_m),
-			     ESPIHUB_VW_HIGH, false);
-	if (ret) {
-		pwrseq_error(ERR_PM_SLP_M);
-		return ret;
-	}
-
+#ifdef CONFIG_ESPI_PERIPHERAL_8042_KBC
+	kbc_enable_interface();
+#endif
+	LOG_INF("%s new state %d", __func__, current_state);
 
-	LOG_DBG("Waiting for ALL_SYS_PWRGD to go HIGH");
-	ret = wait_for_pin(ALL_SYS_PWRGD,
-			   TIMEOUT_TO_US(sw_strps()->timeouts.all_sys_pwrg),
-			   1);
-	if (ret) {
-		pwrseq_error(ERR_ALL_SYS_PWRGD);
-		LOG_ERR("ALL_SYS_PWRGD timed out\n");
-		return ret;
-	}
+	return 0;
+}
 
-	LOG_DBG("ALL_SYS_PWRGD is HIGH");
-	k_busy_wait(VR_ON_RAMP_DELAY_US);
+static int power_on(void)
+{
+	int ret;
 
-#ifdef VCCST_PWRGD
-	ret = gpio_write_pin(VCCST_PWRGD, 1);
-	if (ret) {
-		LOG_ERR("Failed to drive VCCST_PWRGD");
-		return ret;
-	}
+	ret = power_on_sequence();
+#ifdef CONFIG_BOOT_PROFILER
+	boot_prof_end(ret);
 #endif
-	ret = gpio_write_pin(PCH_PWROK, 1);
-	if (ret) {
-		LOG_ERR("Failed to indicate eSPI master to run");
-		return ret;
-	}
 
-	k_msleep(SYS_PWR_OK_DELAY);
+	return ret;
+}
 
-	ret = gpio_write_pin(SYS_PWROK, 1);
-	if (ret) {
-		LOG_ERR("Failed to indicate system power is ok");
-		return ret;
+#ifdef CONFIG_POWER_SEQUENCE_FAST_S3_RESUME
+static bool s3_preconditions(void)
+{
+	uint8_t slp_s4;
+	uint8_t slp_s5;
+
+	/* Suspend well remains powered and out of reset in S3 */
+	if (gpio_read_pin(RSMRST_PWRGD) != 1 || gpio_read_pin(PM_RSMRST) != 1) {
+		return false;
 	}
 
-	ret = gpio_write_pin(WAKE_SCI, 1);
-	if (ret) {
-		LOG_ERR("Failed to indicate eSPI master to wake");
-		return ret;
+	if (espihub_retrieve_vw(ESPI_VWIRE_SIGNAL_SLP_S4, &slp_s4) ||
+	    espihub_retrieve_vw(ESPI_VWIRE_SIGNAL_SLP_S5, &slp_s5)) {
+		return false;
 	}
 
-	ret = wait_for_vwire(ESPI_VWIRE_SIGNAL_PLTRST,
-			     TIMEOUT_TO_US(sw_strps()->timeouts.plt_rst),
-			     ESPIHUB_VW_HIGH, false);
+	return (slp_s4 == ESPIHUB_VW_HIGH && slp_s5 == ESPIHUB_VW_HIGH);
+}
+
+static int fast_resume_sequence(void)
+{
+	int ret;
+
+	LOG_INF("%s", __func__);
+
+#ifdef CONFIG_BOOT_PROFILER
+	boot_prof_set_type(BOOT_PROF_TYPE_S3_S0_FAST);
+	boot_prof_mark(BOOT_PROF_PWRSEQ_START);
+#endif
+#ifdef CONFIG_POSTCODE_MANAGEMENT
+	port80_display_on();
+#endif
+
+	ret = pwrseq_run(&pwrseq_resume);
 	if (ret) {
-		pwrseq_error(ERR_PLT_RST);
 		return ret;
 	}
 
-	gpio_write_pin(EC_PWRBTN_LED, HIGH);
-
 #ifdef CONFIG_ESPI_PERIPHERAL_8042_KBC
 	kbc_enable_interface();
 #endif
-	LOG_INF("%s new state %d", __func__, current_state);
 
 	return 0;
 }
 
+static int fast_resume(void)
+{
+	bool ready = s3_resume_ready;
+	int ret;
+
+	s3_resume_ready = false;
+
+	/* Fall back to full power on if S3 was not entered cleanly or
+	 * any precondition changed while in S3.
+	 */
+	if (!ready || dsx_entered() || !s3_preconditions()) {
+		LOG_WRN("S3 fast resume not possible");
+		return power_on();
+	}
+
+	ret = fast_resume_sequence();
+#ifdef CONFIG_BOOT_PROFILER
+	boot_prof_end(ret);
+#endif
+
+	return ret;
+}
+#endif
+
 static void suspend(void)
 {
 	LOG_DBG("%s", __func__);
 
-	gpio_write_pin(PCH_PWROK, 0);
-	gpio_write_pin(SYS_PWROK, 0);
+#ifdef CONFIG_POWER_SEQUENCE_FAST_S3_RESUME
+	s3_resume_ready = !pwrseq_run(&pwrseq_suspend);
+#else
+	pwrseq_run(&pwrseq_suspend);
+#endif
 	board_suspend();
 #ifdef CONFIG_POSTCODE_MANAGEMENT
 	port80_display_off();
 #endif
+
+#ifdef CONFIG_POWER_SEQUENCE_FAST_S3_RESUME
+	s3_resume_ready = s3_resume_ready && !pwrseq_failure &&
+			  s3_preconditions();
+	LOG_DBG("S3 fast resume %d", s3_resume_ready);
+#endif
 }
 
 static int resume(void)
@@ -927,7 +1056,11 @@ static int resume(void)
 	LOG_DBG("%s", __func__);
 
 	/* Perform power on sequence. If no errors, notify BIOS */
+#ifdef CONFIG_POWER_SEQUENCE_FAST_S3_RESUME
+	ret = fast_resume();
+#else
 	ret = power_on();
+#endif
 	if (!ret) {
 		enqueue_sci(SCI_RESUME);
 	}
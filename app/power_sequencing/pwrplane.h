@@ -26,6 +26,7 @@
 
 #define SHUTDOWN_REASON_DEFAULT			0x0
 #define SHUTDOWN_REASON_CRTITICAL_THERMAL	0x1
+#define SHUTDOWN_REASON_FAN_FAILURE		0x2
 /**
  * @brief Power control flags.
  */
@@ -76,6 +77,15 @@ void pwrseq_error(uint8_t error_code);
  */
 void set_next_state_to_S5(void);
 
+#ifdef CONFIG_PWRSEQ_EVENT_DRIVEN_TASK
+/**
+ * @brief Indicate power sequencing task there is an event to be processed.
+ *
+ * Safe to call from interrupt context.
+ */
+void pwrseq_signal_request(void);
+#endif
+
 /**
  * @brief Indicates current system power state.
  *
@@ -0,0 +1,236 @@
+/*
+ * Copyright (c) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr.h>
+#include <errno.h>
+#include <sys/byteorder.h>
+#include <sys/crc.h>
+#include <logging/log.h>
+#include "eeprom.h"
+#include "system.h"
+#include "pwrplane.h"
+#include "pwrseq_journal.h"
+
+LOG_MODULE_DECLARE(pwrmgmt, CONFIG_PWRMGT_LOG_LEVEL);
+
+/*
+ * Journal is a ring of fixed size entries in EEPROM. Entries are only
+ * appended, so every slot is written once per pass over the ring. Most
+ * recent entry is the valid one with highest sequence number, found by
+ * scanning the ring once per EC boot.
+ */
+#define JOURNAL_ENTRIES		CONFIG_PWRSEQ_JOURNAL_ENTRIES
+#define JOURNAL_EEPROM_PAGE_SIZE	16U
+#define JOURNAL_ERASED_SEQ	UINT32_MAX
+#define JOURNAL_CRC_LEN		offsetof(struct pwrseq_journal_entry, crc)
+
+BUILD_ASSERT(sizeof(struct pwrseq_journal_entry) == JOURNAL_EEPROM_PAGE_SIZE,
+	     "Journal entry must be a single EEPROM page");
+BUILD_ASSERT(CONFIG_PWRSEQ_JOURNAL_EEPROM_OFFSET %
+	     JOURNAL_EEPROM_PAGE_SIZE == 0, "Journal must be page aligned");
+BUILD_ASSERT(CONFIG_PWRSEQ_JOURNAL_EEPROM_OFFSET +
+	     JOURNAL_ENTRIES * JOURNAL_EEPROM_PAGE_SIZE <= EEPROM_SIZE,
+	     "Journal does not fit EEPROM");
+
+/* Event waiting to be written to EEPROM */
+struct journal_evt {
+	uint32_t uptime_ms;
+	uint8_t type;
+	uint8_t pwr_state;
+	uint8_t arg[2];
+};
+
+static void journal_work_handler(struct k_work *work);
+
+K_MSGQ_DEFINE(journal_msgq, sizeof(struct journal_evt),
+	      CONFIG_PWRSEQ_JOURNAL_QUEUE_SIZE, 4);
+K_MUTEX_DEFINE(journal_lock);
+K_WORK_DELAYABLE_DEFINE(journal_work, journal_work_handler);
+
+static bool journal_scanned;
+/* Slot for next entry */
+static uint8_t journal_head;
+static uint8_t journal_used;
+static uint32_t journal_seq;
+static uint16_t journal_boot;
+
+static uint16_t slot_offset(uint8_t slot)
+{
+	return CONFIG_PWRSEQ_JOURNAL_EEPROM_OFFSET +
+	       slot * sizeof(struct pwrseq_journal_entry);
+}
+
+static int slot_read(uint8_t slot, struct pwrseq_journal_entry *entry)
+{
+	int ret;
+
+	ret = eeprom_read_block(slot_offset(slot), sizeof(*entry),
+				(uint8_t *)entry);
+	if (ret) {
+		return -EIO;
+	}
+
+	/* Erased EEPROM or interrupted write */
+	if (sys_le32_to_cpu(entry->seq) == JOURNAL_ERASED_SEQ ||
+	    crc8_ccitt(0, entry, JOURNAL_CRC_LEN) != entry->crc) {
+		return -EINVAL;
+	}
+
+	return 0;
+}
+
+static void journal_scan(void)
+{
+	struct pwrseq_journal_entry entry;
+	bool found = false;
+	uint32_t last = 0;
+	uint16_t boot = 0;
+	uint32_t seq;
+	uint8_t slot;
+
+	journal_used = 0;
+	journal_head = 0;
+
+	for (slot = 0; slot < JOURNAL_ENTRIES; slot++) {
+		if (slot_read(slot, &entry)) {
+			continue;
+		}
+
+		journal_used++;
+		seq = sys_le32_to_cpu(entry.seq);
+		if (!found || seq > last) {
+			found = true;
+			last = seq;
+			boot = sys_le16_to_cpu(entry.boot);
+			journal_head = (slot + 1) % JOURNAL_ENTRIES;
+		}
+	}
+
+	journal_seq = found ? last + 1 : 0;
+	journal_boot = found ? boot + 1 : 0;
+	journal_scanned = true;
+
+	LOG_INF("Journal: %d entries, EC boot %d", journal_used, journal_boot);
+}
+
+static int journal_write(const struct journal_evt *evt)
+{
+	struct pwrseq_journal_entry entry = { 0 };
+	int ret;
+
+	entry.seq = sys_cpu_to_le32(journal_seq);
+	entry.uptime_ms = sys_cpu_to_le32(evt->uptime_ms);
+	entry.boot = sys_cpu_to_le16(journal_boot);
+	entry.type = evt->type;
+	entry.pwr_state = evt->pwr_state;
+	entry.arg[0] = evt->arg[0];
+	entry.arg[1] = evt->arg[1];
+	entry.crc = crc8_ccitt(0, &entry, JOURNAL_CRC_LEN);
+
+	ret = eeprom_write_block(slot_offset(journal_head), sizeof(entry),
+				 (uint8_t *)&entry);
+	if (ret) {
+		return ret;
+	}
+
+	journal_head = (journal_head + 1) % JOURNAL_ENTRIES;
+	journal_used = MIN(journal_used + 1, JOURNAL_ENTRIES);
+	journal_seq++;
+
+	return 0;
+}
+
+static void journal_work_handler(struct k_work *work)
+{
+	pwrseq_journal_flush();
+}
+
+void pwrseq_journal_init(void)
+{
+	pwrseq_journal_record(PWRSEQ_JOURNAL_EC_BOOT, 0, 0);
+}
+
+void pwrseq_journal_record(uint8_t type, uint8_t arg0, uint8_t arg1)
+{
+	struct journal_evt evt = {
+		.uptime_ms = k_uptime_get_32(),
+		.type = type,
+		.pwr_state = pwrseq_system_state(),
+		.arg = { arg0, arg1 },
+	};
+
+	if (k_msgq_put(&journal_msgq, &evt, K_NO_WAIT)) {
+		LOG_WRN("Journal full, event %d dropped", type);
+		return;
+	}
+
+	/* Events close together are written in one batch. Pending update
+	 * is not postponed by further events.
+	 */
+	k_work_schedule(&journal_work,
+			K_MSEC(CONFIG_PWRSEQ_JOURNAL_FLUSH_DELAY_MS));
+}
+
+void pwrseq_journal_flush(void)
+{
+	struct journal_evt evt;
+	int ret;
+
+	k_mutex_lock(&journal_lock, K_FOREVER);
+
+	if (!journal_scanned) {
+		journal_scan();
+	}
+
+	while (!k_msgq_get(&journal_msgq, &evt, K_NO_WAIT)) {
+		ret = journal_write(&evt);
+		if (ret) {
+			LOG_ERR("Failed to write journal %d", ret);
+		}
+	}
+
+	k_mutex_unlock(&journal_lock);
+}
+
+uint8_t pwrseq_journal_count(uint8_t *pending)
+{
+	uint8_t used;
+
+	k_mutex_lock(&journal_lock, K_FOREVER);
+
+	if (!journal_scanned) {
+		journal_scan();
+	}
+
+	used = journal_used;
+	k_mutex_unlock(&journal_lock);
+
+	*pending = k_msgq_num_used_get(&journal_msgq);
+
+	return used;
+}
+
+int pwrseq_journal_read(uint8_t idx, struct pwrseq_journal_entry *entry)
+{
+	int ret;
+
+	k_mutex_lock(&journal_lock, K_FOREVER);
+
+	if (!journal_scanned) {
+		journal_scan();
+	}
+
+	if (idx >= journal_used) {
+		k_mutex_unlock(&journal_lock);
+		return -EINVAL;
+	}
+
+	ret = slot_read((journal_head + JOURNAL_ENTRIES - 1 - idx) %
+			JOURNAL_ENTRIES, entry);
+	k_mutex_unlock(&journal_lock);
+
+	return ret;
+}
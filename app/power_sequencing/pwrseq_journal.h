@@ -0,0 +1,86 @@
+/*
+ * Copyright (c) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef __PWRSEQ_JOURNAL_H__
+#define __PWRSEQ_JOURNAL_H__
+
+#include <zephyr.h>
+
+/* Journal entry types */
+#define PWRSEQ_JOURNAL_EC_BOOT		0x01
+/* Arg 0: previous system state, arg 1: new system state */
+#define PWRSEQ_JOURNAL_TRANSITION	0x02
+/* Arg 0: power sequencing error code, see errcodes.h */
+#define PWRSEQ_JOURNAL_ERROR		0x03
+/* Arg 0: shutdown reason, see SHUTDOWN_REASON_* in pwrplane.h */
+#define PWRSEQ_JOURNAL_SHUTDOWN		0x04
+
+/**
+ * @brief Power sequencing journal entry as stored in EEPROM.
+ *
+ * Entry size matches EEPROM page size, so every entry is a single page
+ * write. Multi-byte fields are little endian.
+ */
+struct pwrseq_journal_entry {
+	/* Increments with every entry across EC boots */
+	uint32_t seq;
+	/* EC uptime when event occurred */
+	uint32_t uptime_ms;
+	/* Number of EC boots since journal was created */
+	uint16_t boot;
+	uint8_t type;
+	/* System power state when event occurred */
+	uint8_t pwr_state;
+	uint8_t arg[2];
+	uint8_t reserved;
+	/* CRC-8 CCITT of all preceding bytes */
+	uint8_t crc;
+} __packed;
+
+/**
+ * @brief Initialize power sequencing journal and record EC boot.
+ */
+void pwrseq_journal_init(void);
+
+/**
+ * @brief Record an event in the journal.
+ *
+ * Event is timestamped and queued, EEPROM is updated later in a batch from
+ * system work queue. Safe to call from interrupt context.
+ *
+ * @param type entry type, see PWRSEQ_JOURNAL_*.
+ * @param arg0 first type specific argument.
+ * @param arg1 second type specific argument.
+ */
+void pwrseq_journal_record(uint8_t type, uint8_t arg0, uint8_t arg1);
+
+/**
+ * @brief Write all queued events to EEPROM.
+ *
+ * Blocking call, intended for thermal shutdown once power rails are off.
+ */
+void pwrseq_journal_flush(void);
+
+/**
+ * @brief Number of entries in EEPROM and events not written yet.
+ *
+ * @param pending number of queued events not yet in EEPROM.
+ *
+ * @retval number of valid entries in EEPROM.
+ */
+uint8_t pwrseq_journal_count(uint8_t *pending);
+
+/**
+ * @brief Read a journal entry from EEPROM.
+ *
+ * @param idx entry index, 0 is the most recent.
+ * @param entry buffer for entry.
+ *
+ * @retval 0 if success, -EINVAL if no such entry, -EIO on EEPROM failure.
+ */
+int pwrseq_journal_read(uint8_t idx, struct pwrseq_journal_entry *entry);
+
+#endif /* __PWRSEQ_JOURNAL_H__ */
@@ -0,0 +1,301 @@
+/*
+ * Copyright (c) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <errno.h>
+#include <zephyr.h>
+#include <logging/log.h>
+#include "gpio_ec.h"
+#include "espi_hub.h"
+#include "softstrap.h"
+#include "pwrplane.h"
+#include "pwrseq_utils.h"
+#include "pwrseq_timeouts.h"
+#include "pwrseq_steps.h"
+#ifdef CONFIG_BOOT_PROFILER
+#include "boot_prof.h"
+#endif
+
+LOG_MODULE_DECLARE(pwrmgmt, CONFIG_PWRMGT_LOG_LEVEL);
+
+static int wait_for_pin_level(uint32_t port_pin, uint16_t timeout,
+			uint32_t exp_level)
+{
+	uint16_t loop_cnt = timeout;
+	int level;
+
+	do {
+		/* Passes the enconded gpio(port_pin) to the gpio driver */
+		level = gpio_read_pin(port_pin);
+		if (level < 0) {
+			LOG_ERR("Failed to read %x ", gpio_get_pin(port_pin));
+			return -EIO;
+		}
+
+		if (exp_level == level) {
+			LOG_DBG("Pin [%o]: %x",
+				get_absolute_gpio_num(port_pin), exp_level);
+			break;
+		}
+
+		k_usleep(PWRSEQ_POLL_PERIOD_US);
+		loop_cnt--;
+	} while (loop_cnt > 0 || (timeout == PWR_SEQ_TIMEOUT_FOREVER) ||
+		ec_timeout_status());
+
+	if (loop_cnt == 0) {
+		LOG_DBG("Timeout [%x]: %x", gpio_get_pin(port_pin), level);
+		return -ETIMEDOUT;
+	}
+
+	return 0;
+}
+
+int pwrseq_wait_pin(uint32_t port_pin, uint16_t timeout, uint32_t exp_level)
+{
+	if (ec_timeout_status()) {
+		timeout = PWR_SEQ_TIMEOUT_FOREVER;
+	}
+
+	return wait_for_pin_level(port_pin, timeout, exp_level);
+}
+
+int pwrseq_wait_vwire(uint8_t signal, uint16_t timeout, uint8_t exp_level,
+		      bool ack_req)
+{
+	if (ec_timeout_status()) {
+		timeout = PWR_SEQ_TIMEOUT_FOREVER;
+	}
+
+	return espihub_wait_for_vwire(signal, timeout, exp_level, ack_req);
+}
+
+static uint16_t step_timeout(const struct pwrseq_step *step)
+{
+	switch (step->tmo_src) {
+	case PWRSEQ_TMO_STRAP_RSMRST_PWRGD:
+		return TIMEOUT_TO_US(sw_strps()->timeouts.rsm_rst_pwrgd);
+	case PWRSEQ_TMO_STRAP_ESPI_RST:
+		return TIMEOUT_TO_US(sw_strps()->timeouts.espi_rst);
+	case PWRSEQ_TMO_STRAP_SUS_WRN:
+		return TIMEOUT_TO_US(sw_strps()->timeouts.sus_wrn);
+	case PWRSEQ_TMO_STRAP_SLP_S5:
+		return TIMEOUT_TO_US(sw_strps()->timeouts.slp_s5);
+	case PWRSEQ_TMO_STRAP_SLP_S4:
+		return TIMEOUT_TO_US(sw_strps()->timeouts.slp_s4);
+	case PWRSEQ_TMO_STRAP_SLP_M:
+		return TIMEOUT_TO_US(sw_strps()->timeouts.slp_m);
+	case PWRSEQ_TMO_STRAP_ALL_SYS_PWRG:
+		return TIMEOUT_TO_US(sw_strps()->timeouts.all_sys_pwrg);
+	case PWRSEQ_TMO_STRAP_PLT_RST:
+		return TIMEOUT_TO_US(sw_strps()->timeouts.plt_rst);
+	case PWRSEQ_TMO_FIXED:
+	default:
+		return step->timeout;
+	}
+}
+
+static int read_signal(const struct pwrseq_step *step)
+{
+	uint8_t level;
+	int ret;
+
+	if (step->type == PWRSEQ_STEP_WAIT_PIN) {
+		return gpio_read_pin(step->signal);
+	}
+
+	ret = espihub_retrieve_vw(step->signal, &level);
+	if (ret) {
+		return -EIO;
+	}
+
+	return level;
+}
+
+int pwrseq_wait_set(const struct pwrseq_step *set, uint8_t num, bool all,
+		    uint8_t *failed)
+{
+	uint16_t timeout[PWRSEQ_WAIT_SET_MAX];
+	uint32_t pending = BIT_MASK(num);
+	uint32_t expired = 0;
+	uint32_t loop_cnt = 0;
+	int level;
+	uint8_t i;
+
+	if (num == 0 || num > PWRSEQ_WAIT_SET_MAX) {
+		return -EINVAL;
+	}
+
+	for (i = 0; i < num; i++) {
+		timeout[i] = step_timeout(&set[i]);
+	}
+
+	while (true) {
+		for (i = 0; i < num; i++) {
+			if (!(pending & BIT(i))) {
+				continue;
+			}
+
+			level = read_signal(&set[i]);
+			if (level < 0) {
+				LOG_ERR("Failed to read %s", set[i].name);
+				*failed = i;
+				return -EIO;
+			}
+
+			if (level == set[i].level) {
+				LOG_DBG("%s: %x", set[i].name, level);
+				pending &= ~BIT(i);
+#ifdef CONFIG_BOOT_PROFILER
+				boot_prof_mark(set[i].mark);
+#endif
+				if (!all) {
+					return 0;
+				}
+			} else if (loop_cnt >= timeout[i] &&
+				   timeout[i] != PWR_SEQ_TIMEOUT_FOREVER &&
+				   !ec_timeout_status()) {
+				LOG_DBG("Timeout %s: %x", set[i].name, level);
+				pending &= ~BIT(i);
+				expired |= BIT(i);
+			}
+		}
+
+		/* Any expired signal fails the set when all are required,
+		 * otherwise only when no signal is left to wait for.
+		 */
+		if ((all && expired) || !pending) {
+			break;
+		}
+
+		k_usleep(PWRSEQ_POLL_PERIOD_US);
+		loop_cnt++;
+	}
+
+	if (expired) {
+		*failed = find_lsb_set(expired) - 1;
+		return -ETIMEDOUT;
+	}
+
+	return 0;
+}
+
+static void step_delay(uint32_t delay_us)
+{
+	if (!delay_us) {
+		return;
+	}
+
+	/* Short delays are timing critical, long ones should not block
+	 * other tasks.
+	 */
+	if (delay_us < PWRSEQ_SLEEP_THRESHOLD_US) {
+		k_busy_wait(delay_us);
+	} else {
+		k_msleep(ceiling_fraction(delay_us, USEC_PER_MSEC));
+	}
+}
+
+static int step_exec(const struct pwrseq_step *step, uint8_t *err)
+{
+	uint8_t failed;
+	int ret;
+
+	*err = step->err;
+
+	switch (step->type) {
+	case PWRSEQ_STEP_WRITE_PIN:
+		ret = gpio_write_pin(step->signal, step->level);
+		break;
+	case PWRSEQ_STEP_WAIT_PIN:
+		ret = pwrseq_wait_pin(step->signal, step_timeout(step),
+				      step->level);
+		break;
+	case PWRSEQ_STEP_WAIT_VWIRE:
+		ret = pwrseq_wait_vwire(step->signal, step_timeout(step),
+					step->level, false);
+		break;
+	case PWRSEQ_STEP_DELAY:
+		ret = 0;
+		break;
+	case PWRSEQ_STEP_CALL:
+		ret = step->call ? step->call() : -EINVAL;
+		break;
+	case PWRSEQ_STEP_WAIT_ALL:
+	case PWRSEQ_STEP_WAIT_ANY:
+		ret = pwrseq_wait_set(step->set, step->set_len,
+				      step->type == PWRSEQ_STEP_WAIT_ALL,
+				      &failed);
+		if (ret && ret != -EINVAL) {
+			*err = step->set[failed].err;
+		}
+		break;
+	default:
+		ret = -EINVAL;
+		break;
+	}
+
+	if (!ret) {
+#ifdef CONFIG_BOOT_PROFILER
+		boot_prof_mark(step->mark);
+#endif
+		step_delay(step->delay_us);
+	}
+
+	return ret;
+}
+
+int pwrseq_run(struct pwrseq_seq *seq)
+{
+	uint32_t start = k_cycle_get_32();
+	uint32_t step_start;
+	int ret = 0;
+	uint8_t err;
+	uint8_t i;
+
+	seq->failed_step = PWRSEQ_STEP_NONE;
+
+	for (i = 0; i < seq->num_steps; i++) {
+		const struct pwrseq_step *step = &seq->steps[i];
+
+		step_start = k_cycle_get_32();
+		ret = step_exec(step, &err);
+		seq->elapsed_us[i] = k_cyc_to_us_floor32(k_cycle_get_32() -
+							 step_start);
+		LOG_DBG("%s: %s %d us", seq->name, step->name,
+			seq->elapsed_us[i]);
+
+		if (ret) {
+			LOG_ERR("%s: %s failed %d", seq->name, step->name, ret);
+			seq->failed_step = i;
+			if (err != ERR_NONE) {
+				pwrseq_error(err);
+			}
+			break;
+		}
+	}
+
+	/* Steps not executed have no timing */
+	for (i++; i < seq->num_steps; i++) {
+		seq->elapsed_us[i] = 0;
+	}
+
+	seq->total_us = k_cyc_to_us_floor32(k_cycle_get_32() - start);
+	LOG_INF("%s: %d us", seq->name, seq->total_us);
+
+	return ret;
+}
+
+int pwrseq_step_elapsed(const struct pwrseq_seq *seq, uint8_t idx,
+			uint32_t *elapsed_us)
+{
+	if (idx >= seq->num_steps) {
+		return -EINVAL;
+	}
+
+	*elapsed_us = seq->elapsed_us[idx];
+
+	return 0;
+}
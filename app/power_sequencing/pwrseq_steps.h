@@ -0,0 +1,275 @@
+/*
+ * Copyright (c) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef __PWRSEQ_STEPS_H__
+#define __PWRSEQ_STEPS_H__
+
+#include <zephyr.h>
+#include "errcodes.h"
+
+/* Delays at or above this threshold yield the CPU instead of busy waiting */
+#define PWRSEQ_SLEEP_THRESHOLD_US	10000U
+
+/* Delay between PWROK signals de-assertion and any further action */
+#define PM_PWROFF_DELAY_US		500U
+
+/* Polling period for power sequence signals */
+#define PWRSEQ_POLL_PERIOD_US		100U
+
+/* Maximum number of signals waited on together */
+#define PWRSEQ_WAIT_SET_MAX		8U
+
+/* No step failed in last execution of a sequence */
+#define PWRSEQ_STEP_NONE		0xFFu
+
+/**
+ * @brief Power sequence step types.
+ */
+enum pwrseq_step_type {
+	/* Drive GPIO to level */
+	PWRSEQ_STEP_WRITE_PIN,
+	/* Wait for GPIO to reach level */
+	PWRSEQ_STEP_WAIT_PIN,
+	/* Wait for eSPI virtual wire to reach level */
+	PWRSEQ_STEP_WAIT_VWIRE,
+	/* Only perform step delay */
+	PWRSEQ_STEP_DELAY,
+	/* Invoke a hook which cannot be described as a signal operation */
+	PWRSEQ_STEP_CALL,
+	/* Wait for all signals in a set of wait steps. Every signal timeout
+	 * counts from the start of the wait, so only signals sharing the same
+	 * platform window belong to one set.
+	 */
+	PWRSEQ_STEP_WAIT_ALL,
+	/* Wait for any signal in a set of wait steps */
+	PWRSEQ_STEP_WAIT_ANY,
+};
+
+/**
+ * @brief Source of timeout for wait steps.
+ *
+ * Timeouts which can be configured via softstraps are read at the time
+ * the step is executed, all others use the timeout in the step.
+ */
+enum pwrseq_tmo_src {
+	PWRSEQ_TMO_FIXED,
+	PWRSEQ_TMO_STRAP_RSMRST_PWRGD,
+	PWRSEQ_TMO_STRAP_ESPI_RST,
+	PWRSEQ_TMO_STRAP_SUS_WRN,
+	PWRSEQ_TMO_STRAP_SLP_S5,
+	PWRSEQ_TMO_STRAP_SLP_S4,
+	PWRSEQ_TMO_STRAP_SLP_M,
+	PWRSEQ_TMO_STRAP_ALL_SYS_PWRG,
+	PWRSEQ_TMO_STRAP_PLT_RST,
+};
+
+/**
+ * @brief Declarative description of a single power sequence step.
+ */
+struct pwrseq_step {
+	/* Short name used in logs and timing reports */
+	const char *name;
+	/* Encoded GPIO port_pin or eSPI virtual wire signal */
+	uint32_t signal;
+	/* Hook for PWRSEQ_STEP_CALL steps */
+	int (*call)(void);
+	/* Pin and virtual wire wait steps for PWRSEQ_STEP_WAIT_ALL/ANY */
+	const struct pwrseq_step *set;
+	uint8_t set_len;
+	/* Delay in us once the step completes successfully */
+	uint32_t delay_us;
+	/* Wait timeout in 100us periods when source is PWRSEQ_TMO_FIXED */
+	uint16_t timeout;
+	uint8_t type;
+	uint8_t level;
+	uint8_t tmo_src;
+	/* Boot profiler event to timestamp on completion, see boot_prof.h */
+	uint8_t mark;
+	/* Error reported via pwrseq_error on failure, ERR_NONE to skip */
+	uint8_t err;
+};
+
+/**
+ * @brief Power sequence and timing of its last execution.
+ */
+struct pwrseq_seq {
+	const char *name;
+	const struct pwrseq_step *steps;
+	uint8_t num_steps;
+	/* Step which failed during last execution or PWRSEQ_STEP_NONE */
+	uint8_t failed_step;
+	/* Elapsed time in us of every step in last execution */
+	uint32_t *elapsed_us;
+	uint32_t total_us;
+};
+
+#define PWRSEQ_WRITE_PIN(_sig, _lvl, _dly, _mark)		\
+	{							\
+		.name = #_sig,					\
+		.type = PWRSEQ_STEP_WRITE_PIN,			\
+		.signal = _sig,					\
+		.level = _lvl,					\
+		.delay_us = _dly,				\
+		.mark = _mark,					\
+	}
+
+#define PWRSEQ_WAIT_PIN(_sig, _lvl, _tmo, _src, _err, _dly, _mark) \
+	{							\
+		.name = #_sig,					\
+		.type = PWRSEQ_STEP_WAIT_PIN,			\
+		.signal = _sig,					\
+		.level = _lvl,					\
+		.timeout = _tmo,				\
+		.tmo_src = _src,				\
+		.err = _err,					\
+		.delay_us = _dly,				\
+		.mark = _mark,					\
+	}
+
+#define PWRSEQ_WAIT_VWIRE(_sig, _lvl, _tmo, _src, _err, _dly, _mark) \
+	{							\
+		.name = #_sig,					\
+		.type = PWRSEQ_STEP_WAIT_VWIRE,			\
+		.signal = _sig,					\
+		.level = _lvl,					\
+		.timeout = _tmo,				\
+		.tmo_src = _src,				\
+		.err = _err,					\
+		.delay_us = _dly,				\
+		.mark = _mark,					\
+	}
+
+#define PWRSEQ_DELAY(_dly)					\
+	{							\
+		.name = "delay",				\
+		.type = PWRSEQ_STEP_DELAY,			\
+		.delay_us = _dly,				\
+	}
+
+#define PWRSEQ_CALL(_fn, _dly)					\
+	{							\
+		.name = #_fn,					\
+		.type = PWRSEQ_STEP_CALL,			\
+		.call = _fn,					\
+		.delay_us = _dly,				\
+	}
+
+#define PWRSEQ_WAIT_ALL(_set, _dly)				\
+	{							\
+		.name = #_set,					\
+		.type = PWRSEQ_STEP_WAIT_ALL,			\
+		.set = _set,					\
+		.set_len = ARRAY_SIZE(_set),			\
+		.delay_us = _dly,				\
+	}
+
+#define PWRSEQ_WAIT_ANY(_set, _dly)				\
+	{							\
+		.name = #_set,					\
+		.type = PWRSEQ_STEP_WAIT_ANY,			\
+		.set = _set,					\
+		.set_len = ARRAY_SIZE(_set),			\
+		.delay_us = _dly,				\
+	}
+
+/**
+ * @brief Define a power sequence along with its timing storage.
+ *
+ * @param _name sequence name.
+ * @param _steps array of struct pwrseq_step.
+ */
+#define PWRSEQ_SEQ_DEFINE(_name, _steps)			\
+	static uint32_t _name##_elapsed[ARRAY_SIZE(_steps)];	\
+	struct pwrseq_seq _name = {				\
+		.name = #_name,					\
+		.steps = _steps,				\
+		.num_steps = ARRAY_SIZE(_steps),		\
+		.failed_step = PWRSEQ_STEP_NONE,		\
+		.elapsed_us = _name##_elapsed,			\
+	}
+
+/**
+ * @brief Platform power sequences.
+ *
+ * Tables are defined in pwrseq_tables.c.
+ */
+extern struct pwrseq_seq pwrseq_slp_check;
+extern struct pwrseq_seq pwrseq_power_on;
+extern struct pwrseq_seq pwrseq_resume;
+extern struct pwrseq_seq pwrseq_power_off;
+extern struct pwrseq_seq pwrseq_suspend;
+
+/**
+ * @brief Wait for a GPIO to reach a level.
+ *
+ * Timeout is ignored if EC timeouts are disabled.
+ *
+ * @param port_pin encoded GPIO.
+ * @param timeout in 100us periods.
+ * @param exp_level expected level.
+ *
+ * @retval 0 if level was reached, -ETIMEDOUT or -EIO otherwise.
+ */
+int pwrseq_wait_pin(uint32_t port_pin, uint16_t timeout, uint32_t exp_level);
+
+/**
+ * @brief Wait for an eSPI virtual wire to reach a level.
+ *
+ * Timeout is ignored if EC timeouts are disabled.
+ *
+ * @param signal eSPI virtual wire.
+ * @param timeout in 100us periods.
+ * @param exp_level expected level.
+ * @param ack_req indicate if virtual wire requires acknowledge.
+ *
+ * @retval 0 if level was reached, negative errno otherwise.
+ */
+int pwrseq_wait_vwire(uint8_t signal, uint16_t timeout, uint8_t exp_level,
+		      bool ack_req);
+
+/**
+ * @brief Wait for a set of GPIOs and eSPI virtual wires to reach levels.
+ *
+ * All signals are polled together, so independent conditions are waited
+ * on concurrently. Every signal has its own timeout, which is ignored if
+ * EC timeouts are disabled, counted from the start of the wait. Boot
+ * profiler event of each signal is timestamped when its level is reached.
+ *
+ * @param set array of PWRSEQ_STEP_WAIT_PIN or PWRSEQ_STEP_WAIT_VWIRE steps.
+ * @param num number of steps in set, up to PWRSEQ_WAIT_SET_MAX.
+ * @param all wait for all signals if true, for any signal otherwise.
+ * @param failed index of signal which caused failure.
+ *
+ * @retval 0 if condition was met, -ETIMEDOUT, -EIO or -EINVAL otherwise.
+ */
+int pwrseq_wait_set(const struct pwrseq_step *set, uint8_t num, bool all,
+		    uint8_t *failed);
+
+/**
+ * @brief Execute all steps in a power sequence in order.
+ *
+ * Execution stops at first failing step, reporting the step error code if
+ * any. Elapsed time of every step including its delay is recorded.
+ *
+ * @param seq power sequence.
+ *
+ * @retval 0 if all steps completed, error of failing step otherwise.
+ */
+int pwrseq_run(struct pwrseq_seq *seq);
+
+/**
+ * @brief Get elapsed time of a step in last execution of a sequence.
+ *
+ * @param seq power sequence.
+ * @param idx step index.
+ * @param elapsed_us elapsed time in us, 0 if step was not executed.
+ *
+ * @retval 0 if success, -EINVAL if step index is invalid.
+ */
+int pwrseq_step_elapsed(const struct pwrseq_seq *seq, uint8_t idx,
+			uint32_t *elapsed_us);
+
+#endif /* __PWRSEQ_STEPS_H__ */
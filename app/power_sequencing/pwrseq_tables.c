@@ -0,0 +1,113 @@
+/*
+ * Copyright (c) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr.h>
+#include <drivers/espi.h>
+#include "gpio_ec.h"
+#include "espi_hub.h"
+#include "board_config.h"
+#include "pwrseq_timeouts.h"
+#include "pwrseq_steps.h"
+#include "boot_prof.h"
+
+/* For more details for below signals refer to platform design guidelines.
+ *
+ * VCCST_PWRGD & PM_PCH_PWROK to be generated together
+ * CONFIG_POWER_SEQUENCE_VR_RAMP_DELAY_US after ALL_SYS_PWRGD.
+ * SYS_PWROK to be generated T36 after PCH_PWROK.
+ */
+#define VR_ON_RAMP_DELAY_US	CONFIG_POWER_SEQUENCE_VR_RAMP_DELAY_US
+#define SYS_PWR_OK_DELAY_US	(CONFIG_POWER_SEQUENCE_SYS_PWROK_DELAY_MS * \
+				 USEC_PER_MSEC)
+
+/* SLPS5#, SLPS4#, SLPS3# signals are released together by PMC, so they are
+ * polled as one set instead of one after another.
+ */
+static const struct pwrseq_step slp_signals[] = {
+	PWRSEQ_WAIT_VWIRE(ESPI_VWIRE_SIGNAL_SLP_S5, ESPIHUB_VW_HIGH,
+			  0, PWRSEQ_TMO_STRAP_SLP_S5, ERR_PM_SLPS5, 0,
+			  BOOT_PROF_NONE),
+	PWRSEQ_WAIT_VWIRE(ESPI_VWIRE_SIGNAL_SLP_S4, ESPIHUB_VW_HIGH,
+			  0, PWRSEQ_TMO_STRAP_SLP_S4, ERR_PM_SLPS4, 0,
+			  BOOT_PROF_NONE),
+	PWRSEQ_WAIT_VWIRE(ESPI_VWIRE_SIGNAL_SLP_S3, ESPIHUB_VW_HIGH,
+			  SLPS3_TIMEOUT, PWRSEQ_TMO_FIXED, ERR_PM_SLPS3, 0,
+			  BOOT_PROF_NONE),
+};
+
+/* ALL_SYS_PWRGD platform window starts once SLP_A is asserted, so both are
+ * waited on in order rather than as a set.
+ */
+#define PWRSEQ_PWRGD_STEPS						\
+	PWRSEQ_WAIT_VWIRE(ESPI_VWIRE_SIGNAL_SLP_A, ESPIHUB_VW_HIGH,	\
+			  0, PWRSEQ_TMO_STRAP_SLP_M, ERR_PM_SLP_M, 0,	\
+			  BOOT_PROF_SLP_A),				\
+	PWRSEQ_WAIT_PIN(ALL_SYS_PWRGD, 1, 0, PWRSEQ_TMO_STRAP_ALL_SYS_PWRG, \
+			ERR_ALL_SYS_PWRGD, VR_ON_RAMP_DELAY_US,		\
+			BOOT_PROF_ALL_SYS_PWRGD)
+
+static const struct pwrseq_step slp_check_steps[] = {
+	PWRSEQ_WAIT_ALL(slp_signals, 0),
+};
+
+/* RSMRST handshake precedes this sequence, since RSMRST signals depend on
+ * boot mode in some boards and cannot be described statically.
+ */
+static const struct pwrseq_step power_on_steps[] = {
+	PWRSEQ_WAIT_ALL(slp_signals, 0),
+	PWRSEQ_PWRGD_STEPS,
+#ifdef VCCST_PWRGD
+	PWRSEQ_WRITE_PIN(VCCST_PWRGD, 1, 0, BOOT_PROF_NONE),
+#endif
+	PWRSEQ_WRITE_PIN(PCH_PWROK, 1, SYS_PWR_OK_DELAY_US,
+			 BOOT_PROF_PCH_PWROK),
+	PWRSEQ_WRITE_PIN(SYS_PWROK, 1, 0, BOOT_PROF_SYS_PWROK),
+	PWRSEQ_WRITE_PIN(WAKE_SCI, 1, 0, BOOT_PROF_NONE),
+	PWRSEQ_WAIT_VWIRE(ESPI_VWIRE_SIGNAL_PLTRST, ESPIHUB_VW_HIGH,
+			  0, PWRSEQ_TMO_STRAP_PLT_RST, ERR_PLT_RST, 0,
+			  BOOT_PROF_PLTRST),
+	PWRSEQ_WRITE_PIN(EC_PWRBTN_LED, HIGH, 0, BOOT_PROF_NONE),
+};
+
+/* Same as power on, except that RSMRST handshake and SLP_S5#/SLP_S4#
+ * de-assertion are validated at S3 entry, see pwrplane.c.
+ */
+static const struct pwrseq_step resume_steps[] = {
+	PWRSEQ_WAIT_VWIRE(ESPI_VWIRE_SIGNAL_SLP_S3, ESPIHUB_VW_HIGH,
+			  SLPS3_TIMEOUT, PWRSEQ_TMO_FIXED, ERR_PM_SLPS3, 0,
+			  BOOT_PROF_NONE),
+	PWRSEQ_PWRGD_STEPS,
+#ifdef VCCST_PWRGD
+	PWRSEQ_WRITE_PIN(VCCST_PWRGD, 1, 0, BOOT_PROF_NONE),
+#endif
+	PWRSEQ_WRITE_PIN(PCH_PWROK, 1, SYS_PWR_OK_DELAY_US,
+			 BOOT_PROF_PCH_PWROK),
+	PWRSEQ_WRITE_PIN(SYS_PWROK, 1, 0, BOOT_PROF_SYS_PWROK),
+	PWRSEQ_WRITE_PIN(WAKE_SCI, 1, 0, BOOT_PROF_NONE),
+	PWRSEQ_WAIT_VWIRE(ESPI_VWIRE_SIGNAL_PLTRST, ESPIHUB_VW_HIGH,
+			  0, PWRSEQ_TMO_STRAP_PLT_RST, ERR_PLT_RST, 0,
+			  BOOT_PROF_PLTRST),
+	PWRSEQ_WRITE_PIN(EC_PWRBTN_LED, HIGH, 0, BOOT_PROF_NONE),
+};
+
+static const struct pwrseq_step power_off_steps[] = {
+#ifdef VCCST_PWRGD
+	PWRSEQ_WRITE_PIN(VCCST_PWRGD, 0, 0, BOOT_PROF_NONE),
+#endif
+	PWRSEQ_WRITE_PIN(SYS_PWROK, 0, 0, BOOT_PROF_NONE),
+	PWRSEQ_WRITE_PIN(PCH_PWROK, 0, PM_PWROFF_DELAY_US, BOOT_PROF_NONE),
+};
+
+static const struct pwrseq_step suspend_steps[] = {
+	PWRSEQ_WRITE_PIN(PCH_PWROK, 0, 0, BOOT_PROF_NONE),
+	PWRSEQ_WRITE_PIN(SYS_PWROK, 0, 0, BOOT_PROF_NONE),
+};
+
+PWRSEQ_SEQ_DEFINE(pwrseq_slp_check, slp_check_steps);
+PWRSEQ_SEQ_DEFINE(pwrseq_power_on, power_on_steps);
+PWRSEQ_SEQ_DEFINE(pwrseq_resume, resume_steps);
+PWRSEQ_SEQ_DEFINE(pwrseq_power_off, power_off_steps);
+PWRSEQ_SEQ_DEFINE(pwrseq_suspend, suspend_steps);
@@ -15,11 +15,102 @@
 #include "pwrplane.h"
 #include "espi_hub.h"
 #include "acpi.h"
+#include "scicodes.h"
+#include "memops.h"
 LOG_MODULE_REGISTER(sci, CONFIG_SMCHOST_LOG_LEVEL);
 
 struct acpi_state_flags g_acpi_state_flags;
 
-K_MSGQ_DEFINE(sci_msgq, sizeof(uint8_t), SCIQ_SIZE, sizeof(uint8_t));
+/* SCI events are delivered to OS from highest to lowest priority */
+enum sci_priority {
+	SCI_PRIO_POWER,
+	SCI_PRIO_THERMAL,
+	SCI_PRIO_DEFAULT,
+	SCI_PRIO_HID,
+	SCI_PRIO_TOTAL,
+};
+
+struct sci_fifo {
+	uint8_t buf[SCIQ_SIZE];
+	uint8_t head;
+	uint8_t count;
+};
+
+#define SCI_MAP_WORDS		((UINT8_MAX + 1) / 32)
+#define SCI_MAP_IDX(code)	((code) >> 5)
+#define SCI_MAP_BIT(code)	BIT((code) & 0x1F)
+
+static struct sci_fifo sci_queue[SCI_PRIO_TOTAL];
+/* Events currently pending in any queue, used to coalesce duplicates */
+static uint32_t sci_pending_map[SCI_MAP_WORDS];
+static uint8_t sci_queued;
+static struct sci_stats sci_stats;
+static struct k_spinlock sci_lock;
+
+static enum sci_priority sci_event_priority(uint8_t code)
+{
+	switch (code) {
+	case SCI_ACINSERTION:
+	case SCI_ACREMOVAL:
+	case SCI_BATTERY:
+	case SCI_BATTERY_PRSNT:
+	case SCI_PSRC_CHANGE:
+	case SCI_LID:
+	case SCI_PWRBTN:
+	case SCI_RESUME:
+	case SCI_PB:
+	case SCI_PWRBTN_DOWN:
+	case SCI_PWRBTN_UP:
+		return SCI_PRIO_POWER;
+	case SCI_THERMAL:
+	case SCI_THERMTRIP:
+	case SCI_FAN_FAIL:
+	case SCI_THERM_PREDICT:
+		return SCI_PRIO_THERMAL;
+	case SCI_HOTKEY:
+	case SCI_HOTKEY_CAS:
+	case SCI_VU_PRES:
+	case SCI_VU_REL:
+	case SCI_VD_PRES:
+	case SCI_VD_REL:
+	case SCI_HB_PRES:
+	case SCI_HB_REL:
+	case SCI_ROT_PRES:
+	case SCI_ROT_REL:
+	case SCI_SLATEMODE_PRESS:
+	case SCI_SLATEMODE_RELEASE:
+	case SCI_AON_UP:
+	case SCI_AON_DOWN:
+	case SCI_AON_SELECT:
+	case SCI_AON_ESC:
+	case SCI_AON_GESC:
+		return SCI_PRIO_HID;
+	default:
+		return SCI_PRIO_DEFAULT;
+	}
+}
+
+/* Must be called with sci_lock held */
+static int sci_dequeue(uint8_t *code)
+{
+	struct sci_fifo *q;
+
+	for (int prio = 0; prio < SCI_PRIO_TOTAL; prio++) {
+		q = &sci_queue[prio];
+		if (q->count == 0) {
+			continue;
+		}
+
+		*code = q->buf[q->head];
+		q->head = (q->head + 1) % SCIQ_SIZE;
+		q->count--;
+		sci_queued--;
+		sci_pending_map[SCI_MAP_IDX(*code)] &= ~SCI_MAP_BIT(*code);
+		return 0;
+	}
+
+	return -ENOMSG;
+}
 
 void sci_queue_init(void)
 {
@@ -28,20 +119,96 @@ void sci_queue_init(void)
 
 void sci_queue_flush(void)
 {
-	LOG_DBG("%s %d SCI flushed", __func__, k_msgq_num_used_get(&sci_msgq));
-	k_msgq_purge(&sci_msgq);
+	k_spinlock_key_t key = k_spin_lock(&sci_lock);
+
+	LOG_DBG("%s %d SCI flushed", __func__, sci_queued);
+	memsets(sci_queue, 0, sizeof(sci_queue));
+	memsets(sci_pending_map, 0, sizeof(sci_pending_map));
+	sci_queued = 0;
+	k_spin_unlock(&sci_lock, key);
+}
+
+void sci_get_stats(struct sci_stats *stats)
+{
+	k_spinlock_key_t key = k_spin_lock(&sci_lock);
+
+	*stats = sci_stats;
+	k_spin_unlock(&sci_lock, key);
+}
+
+#ifdef CONFIG_SMCHOST_SCI_OVER_ESPI
+/* SCI pulse is driven from a timer so callers never spin.
+ * Requests while the pulse is asserted are merged into it, requests during
+ * the hold-off time after de-assertion produce a single additional pulse.
+ */
+enum sci_pulse_state {
+	SCI_PULSE_IDLE,
+	SCI_PULSE_ASSERTED,
+	SCI_PULSE_HOLDOFF,
+};
+
+static enum sci_pulse_state sci_pulse;
+static bool sci_pulse_requested;
+static struct k_spinlock sci_pulse_lock;
+
+static void sci_pulse_expiry(struct k_timer *timer);
+K_TIMER_DEFINE(sci_pulse_timer, sci_pulse_expiry, NULL);
+
+static void sci_pulse_assert(void)
+{
+	if (espihub_send_vw(ESPI_VWIRE_SIGNAL_SCI, ESPIHUB_VW_LOW)) {
+		LOG_WRN("SCI failed");
+	}
+
+	sci_pulse = SCI_PULSE_ASSERTED;
+	k_timer_start(&sci_pulse_timer,
+		      K_USEC(CONFIG_SMCHOST_SCI_PULSE_WIDTH_US), K_NO_WAIT);
+}
+
+static void sci_pulse_expiry(struct k_timer *timer)
+{
+	k_spinlock_key_t key = k_spin_lock(&sci_pulse_lock);
+
+	switch (sci_pulse) {
+	case SCI_PULSE_ASSERTED:
+		if (espihub_send_vw(ESPI_VWIRE_SIGNAL_SCI, ESPIHUB_VW_HIGH)) {
+			LOG_WRN("SCI failed");
+		}
+
+		sci_pulse = SCI_PULSE_HOLDOFF;
+		k_timer_start(timer,
+			      K_USEC(CONFIG_SMCHOST_SCI_MIN_SPACING_US),
+			      K_NO_WAIT);
+		break;
+	case SCI_PULSE_HOLDOFF:
+		/* Conditions may have changed since request was merged */
+		if (sci_pulse_requested && g_acpi_state_flags.sci_enabled &&
+		    g_acpi_state_flags.acpi_mode) {
+			sci_pulse_requested = false;
+			sci_pulse_assert();
+		} else {
+			sci_pulse_requested = false;
+			sci_pulse = SCI_PULSE_IDLE;
+		}
+		break;
+	default:
+		break;
+	}
+
+	k_spin_unlock(&sci_pulse_lock, key);
 }
+#endif
 
 /* System control interrupt are used to notify OS of ACPI events,
  * Do not send SCI when not in acpi mode or system is in Sx.
  * SCI is a pulse so need to send a eSPI virtual wire packet with zero then
- * then another eSPI VW packet with one.
- * eSPI driver should guarantee both virtual are transmitted, a delay between
- * packets should never be added here.
+ * another eSPI VW packet with one once pulse timer expires.
  */
 void generate_sci(void)
 {
-	int ret;
+#ifdef CONFIG_SMCHOST_SCI_OVER_ESPI
+	k_spinlock_key_t key;
+#endif
 
 	if ((!g_acpi_state_flags.sci_enabled) ||
 	    (!g_acpi_state_flags.acpi_mode)) {
@@ -51,16 +218,19 @@ void generate_sci(void)
 
 	if (pwrseq_system_state() == SYSTEM_S0_STATE) {
 #ifdef CONFIG_SMCHOST_SCI_OVER_ESPI
-		ret = espihub_send_vw(ESPI_VWIRE_SIGNAL_SCI, ESPIHUB_VW_LOW);
-		if (ret) {
-			LOG_WRN("SCI failed");
-		}
-		k_busy_wait(100);
-
-		ret = espihub_send_vw(ESPI_VWIRE_SIGNAL_SCI, ESPIHUB_VW_HIGH);
-		if (ret) {
-			LOG_WRN("SCI failed");
+		key = k_spin_lock(&sci_pulse_lock);
+		switch (sci_pulse) {
+		case SCI_PULSE_IDLE:
+			sci_pulse_assert();
+			break;
+		case SCI_PULSE_HOLDOFF:
+			sci_pulse_requested = true;
+			break;
+		default:
+			/* Merged into the pulse in progress */
+			break;
 		}
+		k_spin_unlock(&sci_pulse_lock, key);
 #else
 #warning "SCI using physical pin not supported"
 #endif
@@ -76,7 +246,7 @@ void check_sci_queue(void)
 		return;
 	}
 
-	if (k_msgq_num_used_get(&sci_msgq) == 0) {
+	if (sci_queued == 0) {
 		acpi_set_flag(ACPI_EC_0, ACPI_FLAG_SCIEVENT, 0);
 	} else {
 		LOG_DBG("SCI pending");
@@ -89,13 +259,14 @@ bool sci_pending(void)
 {
 	return (g_acpi_state_flags.sci_enabled &&
 		g_acpi_state_flags.acpi_mode &&
-		k_msgq_num_used_get(&sci_msgq) > 0);
+		sci_queued > 0);
 }
 
 void send_sci_events(void)
 {
 	int ret;
 	uint8_t evt_byte = 0;
+	k_spinlock_key_t key;
 
 	if (!g_acpi_state_flags.acpi_mode) {
 		return;
@@ -106,16 +277,11 @@ void send_sci_events(void)
 		return;
 	}
 
-	ret = k_msgq_get(&sci_msgq, &evt_byte, K_NO_WAIT);
-	if (ret < 0) {
-		switch (ret) {
-		case -ENOMSG:
-			LOG_DBG("SCI msgq Empty!");
-			break;
-		default:
-			LOG_ERR("SCI Queue Fetch failure %02x", ret);
-			return;
-		}
+	key = k_spin_lock(&sci_lock);
+	ret = sci_dequeue(&evt_byte);
+	k_spin_unlock(&sci_lock, key);
+	if (ret == -ENOMSG) {
+		LOG_DBG("SCI queue Empty!");
 	}
 
 	acpi_write_odr(ACPI_EC_0, evt_byte);
@@ -128,7 +294,8 @@ void send_sci_events(void)
 
 void enqueue_sci(uint8_t code)
 {
-	int ret;
+	struct sci_fifo *q;
+	k_spinlock_key_t key;
 
 	if ((!g_acpi_state_flags.sci_enabled) ||
 	    (!g_acpi_state_flags.acpi_mode)) {
@@ -137,10 +304,26 @@ void enqueue_sci(uint8_t code)
 	}
 
 	if (pwrseq_system_state() == SYSTEM_S0_STATE) {
-		LOG_INF("enqueued SCI %02x", code);
-		ret = k_msgq_put(&sci_msgq, (void *)&code, K_NO_WAIT);
-		if (ret < 0) {
-			LOG_ERR("SCI msgq Put failure %02x", ret);
+		q = &sci_queue[sci_event_priority(code)];
+
+		key = k_spin_lock(&sci_lock);
+		if (sci_pending_map[SCI_MAP_IDX(code)] & SCI_MAP_BIT(code)) {
+			/* Same event already pending, OS gets it only once */
+			sci_stats.coalesced++;
+			k_spin_unlock(&sci_lock, key);
+			LOG_DBG("SCI %02x coalesced", code);
+		} else if (q->count >= SCIQ_SIZE) {
+			sci_stats.dropped++;
+			k_spin_unlock(&sci_lock, key);
+			LOG_ERR("SCI queue full, dropped %02x", code);
+		} else {
+			q->buf[(q->head + q->count) % SCIQ_SIZE] = code;
+			q->count++;
+			sci_queued++;
+			sci_pending_map[SCI_MAP_IDX(code)] |= SCI_MAP_BIT(code);
+			sci_stats.queued++;
+			k_spin_unlock(&sci_lock, key);
+			LOG_INF("enqueued SCI %02x", code);
 		}
 	} else {
 		LOG_WRN("SCI not queued, power check failed %02x", code);
@@ -7,9 +7,22 @@
 #ifndef __SCI_H__
 #define __SCI_H__
 
-/* Size of SMC to SCI host buffer */
+/* Size of SMC to SCI host buffer, per priority level */
 #define SCIQ_SIZE               32
 
+/**
+ * @brief SCI queue statistics.
+ *
+ * @param queued events accepted in the queue.
+ * @param coalesced events merged with an identical event already pending.
+ * @param dropped events lost because their priority queue was full.
+ */
+struct sci_stats {
+	uint32_t queued;
+	uint32_t coalesced;
+	uint32_t dropped;
+};
+
 /**
  * @brief  Initialize the SCI Queue.
  */
@@ -54,10 +67,20 @@ void send_sci_events(void);
 /**
  * @brief Stores data to send to the operating system in the SCI queue.
  *
+ * Events are queued per priority: power/lid, thermal, others and HID.
+ * An event already pending is not queued again.
+ *
  * @param code the byte to push onto queue.
  */
 void enqueue_sci(uint8_t Code);
 
+/**
+ * @brief Get SCI queue statistics.
+ *
+ * @param stats pointer where the statistics are copied.
+ */
+void sci_get_stats(struct sci_stats *stats);
+
 /**
  * @brief Check if system is in ACPI mode or not.
  *
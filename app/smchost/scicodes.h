@@ -133,5 +133,9 @@
 #define SCI_THERMAL             0xF0
 /* Thermal trip point transition */
 #define SCI_THERMTRIP           0xF1
+/* Fan stall detected */
+#define SCI_FAN_FAIL            0xF2
+/* CPU predicted to reach critical temperature, EC throttling */
+#define SCI_THERM_PREDICT       0xF3
 
 #endif /* SCI_CODES_H_ */
@@ -5,6 +5,8 @@
  */
 
 #include <errno.h>
+#include <stddef.h>
+#include <string.h>
 #include <zephyr.h>
 #include <device.h>
 #include <soc.h>
@@ -631,25 +633,25 @@ static const bool acpi_tbl_attr[256] = {
 	/* [201 / C9] uint8_t acpi_dis_btn_sci; */
 	ACPI_ATTR_READ_WRITE,
 
-	/* [202 / CA] uint8_t acpi_unused_v[7]; */
+	/* [202 / CA] uint16_t acpi_rear_fan_rpm; */
 	ACPI_ATTR_READ_ONLY,
 
 	/* [203 / CB]  */
 	ACPI_ATTR_READ_ONLY,
 
-	/* [204 / CC]  */
+	/* [204 / CC] uint16_t acpi_gfx_fan_rpm; */
 	ACPI_ATTR_READ_ONLY,
 
 	/* [205 / CD]  */
 	ACPI_ATTR_READ_ONLY,
 
-	/* [206 / CE]  */
+	/* [206 / CE] uint16_t acpi_pch_fan_rpm; */
 	ACPI_ATTR_READ_ONLY,
 
 	/* [207 / CF]  */
 	ACPI_ATTR_READ_ONLY,
 
-	/* [208 / D0]  */
+	/* [208 / D0] uint8_t acpi_unused_v; */
 	ACPI_ATTR_READ_ONLY,
 
 	/* [209 / D1] uint8_t acpi_bat_1_design_cap_l; */
@@ -796,6 +798,159 @@ static const bool acpi_tbl_attr[256] = {
 
 static uint8_t g_wake_status;
 
+/* Longest ACPI field latched for host byte-wise reads */
+#define ACPI_LATCH_MAX_LEN	4u
+/* Host reads remaining bytes of a field right after the first one, a later
+ * read of those bytes gets current data instead of the latched value.
+ */
+#define ACPI_LATCH_TIMEOUT_MS	10u
+
+#define ACPI_BITMAP_WORDS	((ACPI_MAX_DATA + 1) / 32)
+
+/* Writers publish into g_acpi_tbl with interrupts locked, so ACPI peripheral
+ * callback never observes a partial update. Sequence count allows thread
+ * readers to take lock-free consistent snapshots.
+ */
+static struct k_spinlock acpi_tbl_lock;
+static volatile uint32_t acpi_tbl_seq;
+static uint32_t acpi_tbl_dirty[ACPI_BITMAP_WORDS];
+/* Bytes that belong to a multi-byte field other than its first byte */
+static uint32_t acpi_tbl_cont[ACPI_BITMAP_WORDS];
+
+/* Multi-byte field value latched when host reads its first byte */
+static uint8_t acpi_latch[ACPI_LATCH_MAX_LEN];
+static uint8_t acpi_latch_base;
+static uint8_t acpi_latch_len;
+static uint8_t acpi_latch_next;
+static uint32_t acpi_latch_time;
+
+static inline void acpi_bitmap_set(uint32_t *map, uint8_t offset)
+{
+	map[offset / 32] |= BIT(offset % 32);
+}
+
+static inline bool acpi_bitmap_test(const uint32_t *map, uint8_t offset)
+{
+	return (map[offset / 32] & BIT(offset % 32)) != 0;
+}
+
+static bool acpi_tbl_write_locked(uint8_t offset, const uint8_t *data,
+				  uint8_t len)
+{
+	uint8_t *tbl = (uint8_t *)&g_acpi_tbl;
+	bool changed = false;
+
+	acpi_tbl_seq++;
+	compiler_barrier();
+
+	for (uint8_t i = 0; i < len; i++) {
+		if (i > 0) {
+			acpi_bitmap_set(acpi_tbl_cont, offset + i);
+		}
+
+		if (tbl[offset + i] != data[i]) {
+			tbl[offset + i] = data[i];
+			acpi_bitmap_set(acpi_tbl_dirty, offset + i);
+			changed = true;
+		}
+	}
+
+	compiler_barrier();
+	acpi_tbl_seq++;
+
+	return changed;
+}
+
+bool smc_acpi_publish(uint8_t offset, const void *data, uint8_t len)
+{
+	k_spinlock_key_t key;
+	bool changed;
+
+	if ((offset + len) > sizeof(g_acpi_tbl)) {
+		LOG_ERR("Invalid ACPI range %x %d", offset, len);
+		return false;
+	}
+
+	key = k_spin_lock(&acpi_tbl_lock);
+	changed = acpi_tbl_write_locked(offset, data, len);
+	k_spin_unlock(&acpi_tbl_lock, key);
+
+	return changed;
+}
+
+void smc_acpi_snapshot(uint8_t offset, void *data, uint8_t len)
+{
+	uint32_t seq;
+
+	if ((offset + len) > sizeof(g_acpi_tbl)) {
+		LOG_ERR("Invalid ACPI range %x %d", offset, len);
+		return;
+	}
+
+	do {
+		seq = acpi_tbl_seq;
+		compiler_barrier();
+		memcpy(data, (uint8_t *)&g_acpi_tbl + offset, len);
+		compiler_barrier();
+	} while ((seq & 1) || (seq != acpi_tbl_seq));
+}
+
+bool smc_acpi_test_clear_dirty(uint8_t offset, uint8_t len)
+{
+	k_spinlock_key_t key;
+	bool dirty = false;
+
+	key = k_spin_lock(&acpi_tbl_lock);
+	for (uint8_t i = 0; i < len; i++) {
+		uint8_t idx = offset + i;
+
+		if (acpi_bitmap_test(acpi_tbl_dirty, idx)) {
+			acpi_tbl_dirty[idx / 32] &= ~BIT(idx % 32);
+			dirty = true;
+		}
+	}
+	k_spin_unlock(&acpi_tbl_lock, key);
+
+	return dirty;
+}
+
+uint8_t smc_acpi_host_read(uint8_t offset)
+{
+	uint8_t *tbl = (uint8_t *)&g_acpi_tbl;
+	k_spinlock_key_t key;
+	uint8_t len = 1;
+	uint8_t data;
+
+	key = k_spin_lock(&acpi_tbl_lock);
+
+	/* Host continues reading a latched field in ascending order */
+	if (acpi_latch_len && offset == acpi_latch_next &&
+	    (offset - acpi_latch_base) < acpi_latch_len &&
+	    (k_uptime_get_32() - acpi_latch_time) < ACPI_LATCH_TIMEOUT_MS) {
+		data = acpi_latch[offset - acpi_latch_base];
+		acpi_latch_next++;
+		k_spin_unlock(&acpi_tbl_lock, key);
+		return data;
+	}
+
+	while (len < ACPI_LATCH_MAX_LEN &&
+	       (offset + len) < sizeof(g_acpi_tbl) &&
+	       acpi_bitmap_test(acpi_tbl_cont, offset + len)) {
+		len++;
+	}
+
+	memcpy(acpi_latch, &tbl[offset], len);
+	acpi_latch_time = k_uptime_get_32();
+	acpi_latch_base = offset;
+	acpi_latch_next = offset + 1;
+	acpi_latch_len = len;
+	data = acpi_latch[0];
+
+	k_spin_unlock(&acpi_tbl_lock, key);
+
+	return data;
+}
+
 uint8_t smc_get_wake_sts(void)
 {
 	return g_wake_status;
@@ -815,27 +970,24 @@ void smc_generate_wake(uint8_t wake_reason)
 
 void smc_update_thermal_sensor(enum acpi_thrm_sens_idx idx, int16_t temp)
 {
+	uint16_t val = temp;
+
 	switch (idx) {
 	case ACPI_THRM_SEN_1:
-		g_acpi_tbl.acpi_sen1 = temp;
+		SMC_ACPI_PUBLISH(acpi_sen1, val);
 		break;
-
 	case ACPI_THRM_SEN_2:
-		g_acpi_tbl.acpi_sen2 = temp;
+		SMC_ACPI_PUBLISH(acpi_sen2, val);
 		break;
-
 	case ACPI_THRM_SEN_3:
-		g_acpi_tbl.acpi_sen3 = temp;
+		SMC_ACPI_PUBLISH(acpi_sen3, val);
 		break;
-
 	case ACPI_THRM_SEN_4:
-		g_acpi_tbl.acpi_sen4 = temp;
+		SMC_ACPI_PUBLISH(acpi_sen4, val);
 		break;
-
 	case ACPI_THRM_SEN_5:
-		g_acpi_tbl.acpi_sen5 = temp;
+		SMC_ACPI_PUBLISH(acpi_sen5, val);
 		break;
-
 	default:
 		break;
 	}
@@ -843,28 +995,40 @@ void smc_update_thermal_sensor(enum acpi_thrm_sens_idx idx, int16_t temp)
 
 void smc_update_gpu_temperature(int temp)
 {
-	g_acpi_tbl.acpi_gpu_temp = temp;
+	uint8_t val = temp;
+
+	SMC_ACPI_PUBLISH(acpi_gpu_temp, val);
 }
 
 void smc_update_cpu_temperature(int temp)
 {
-	g_acpi_tbl.acpi_remote_temp = temp;
+	uint8_t val = temp;
+
+	SMC_ACPI_PUBLISH(acpi_remote_temp, val);
 }
 
 void smc_update_pch_dts_temperature(int temp)
 {
-	g_acpi_tbl.acpi_pch_dts_temp = temp;
+	uint8_t val = temp;
+
+	SMC_ACPI_PUBLISH(acpi_pch_dts_temp, val);
 }
 
 void smc_update_fan_tach(uint8_t fan_idx, uint16_t rpm)
 {
 	switch (fan_idx) {
 	case FAN_CPU:
-		g_acpi_tbl.acpi_cpu_fan_rpm = rpm;
+		SMC_ACPI_PUBLISH(acpi_cpu_fan_rpm, rpm);
 		break;
-
 	case FAN_REAR:
+		SMC_ACPI_PUBLISH(acpi_rear_fan_rpm, rpm);
+		break;
 	case FAN_GFX:
+		SMC_ACPI_PUBLISH(acpi_gfx_fan_rpm, rpm);
+		break;
+	case FAN_PCH:
+		SMC_ACPI_PUBLISH(acpi_pch_fan_rpm, rpm);
+		break;
 	default:
 		LOG_WRN("Missing acpi fields for fan %d", fan_idx);
 		break;
@@ -873,15 +1037,28 @@ void smc_update_fan_tach(uint8_t fan_idx, uint16_t rpm)
 
 void smc_update_therm_trip_status(uint16_t status)
 {
-	if (status) {
-		/* Send Therm_trip SCI only when local copy of sensor trip
-		 * status changes i.e. a non zero status.
-		 * ACPI sensor status can be read & modified by the host.
-		 * Typically DTT clears the status right after its read.
-		 */
-		LOG_WRN("Trip stat %x %x", status,
-			g_acpi_tbl.acpi_therm_snsr_sts);
-		g_acpi_tbl.acpi_therm_snsr_sts |= status;
+	uint8_t offset = SMC_ACPI_OFFSET(acpi_therm_snsr_sts);
+	k_spinlock_key_t key;
+	uint16_t sts;
+
+	if (!status) {
+		return;
+	}
+
+	/* ACPI sensor status can be read & modified by the host.
+	 * Typically DTT clears the status right after its read, so merge
+	 * with current value while holding the lock.
+	 */
+	key = k_spin_lock(&acpi_tbl_lock);
+	sts = g_acpi_tbl.acpi_therm_snsr_sts | status;
+	acpi_tbl_write_locked(offset, (uint8_t *)&sts, sizeof(sts));
+	k_spin_unlock(&acpi_tbl_lock, key);
+
+	/* Send Therm_trip SCI only when sensor trip status visible to host
+	 * changes, bits still pending host acknowledge need no new SCI.
+	 */
+	if (smc_acpi_test_clear_dirty(offset, sizeof(sts))) {
+		LOG_WRN("Trip stat %x %x", status, sts);
 		enqueue_sci(SCI_THERMTRIP);
 	}
 }
@@ -7,6 +7,7 @@
 #ifndef __SMC_H__
 #define __SMC_H__
 
+#include <stddef.h>
 #include <soc.h>
 #include "acpi_region.h"
 
@@ -57,8 +58,66 @@ enum wake_reason {
 };
 
 
+/** Offset of a field in ACPI region */
+#define SMC_ACPI_OFFSET(field)	offsetof(struct acpi_tbl, field)
+
+/** Publish a local copy of an ACPI region field */
+#define SMC_ACPI_PUBLISH(field, val)					\
+	smc_acpi_publish(SMC_ACPI_OFFSET(field), &(val),		\
+			 sizeof(g_acpi_tbl.field))
+
 void smc_init(void);
 
+/**
+ * @brief Publish an update to ACPI region.
+ *
+ * Range is updated with interrupts locked so host never observes a partially
+ * updated field. Changed bytes are marked dirty.
+ *
+ * @param offset acpi table offset.
+ * @param data pointer to new field value.
+ * @param len field length in bytes.
+ *
+ * @retval true if any byte changed, otherwise false.
+ */
+bool smc_acpi_publish(uint8_t offset, const void *data, uint8_t len);
+
+/**
+ * @brief Take a consistent copy of an ACPI region range.
+ *
+ * Lock-free sequence reader, retries if a writer published meanwhile.
+ *
+ * @param offset acpi table offset.
+ * @param data buffer to hold the copy.
+ * @param len range length in bytes.
+ */
+void smc_acpi_snapshot(uint8_t offset, void *data, uint8_t len);
+
+/**
+ * @brief Check and clear dirty state of an ACPI region range.
+ *
+ * Allows to notify host only when a published value actually changed.
+ *
+ * @param offset acpi table offset.
+ * @param len range length in bytes.
+ *
+ * @retval true if any byte in range changed since last check.
+ */
+bool smc_acpi_test_clear_dirty(uint8_t offset, uint8_t len);
+
+/**
+ * @brief Read ACPI region byte on behalf of host.
+ *
+ * Host reads multi-byte fields one byte at a time. Whole field is latched
+ * when its first byte is read, so following bytes read in ascending order
+ * shortly after belong to the same value.
+ *
+ * @param offset acpi table offset.
+ *
+ * @retval byte value.
+ */
+uint8_t smc_acpi_host_read(uint8_t offset);
+
 /**
  * @brief Generates a wake event via SCI.
  */
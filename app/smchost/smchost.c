@@ -19,6 +19,7 @@
 #include "espi_hub.h"
 #include "peci_hub.h"
 #include "led.h"
+#include "memops.h"
 #ifdef CONFIG_DNX_SUPPORT
 #include "dnx.h"
 #endif
@@ -26,7 +27,7 @@
 LOG_MODULE_REGISTER(smchost, CONFIG_SMCHOST_LOG_LEVEL);
 
 uint8_t host_req[SMCHOST_MAX_BUF_SIZE];
-uint8_t host_res[SMCHOST_MAX_BUF_SIZE];
+uint8_t host_res[SMCHOST_MAX_RES_SIZE];
 uint8_t host_req_len;
 uint8_t host_res_len;
 uint8_t host_res_idx;
@@ -36,7 +37,12 @@ struct acpi_tbl g_acpi_tbl;
 
 static bool proc_host_send(void);
 static void proc_acpi_burst(void);
+static void acpi_burst_exit(void);
 static void service_system_acpi_cmds(void);
+static void service_host_requests(void);
+static void acpi_read_ec(uint8_t acpi_idx);
+static void acpi_write_ec(uint8_t acpi_idx, uint8_t data);
+static void acpi_query_ec(void);
 static uint8_t smchost_req_length(uint8_t command);
 static void smchost_cmd_handler(uint8_t command);
 static void handle_kb_backlight_pwm(void);
@@ -48,6 +54,46 @@ static uint8_t acpi_normal_flag;
 /* PLT_RST# status */
 static uint8_t pltrst_signal_sts;
 
+#ifdef CONFIG_SMCHOST_ACPI_BURST_FAST_PATH
+#define ACPI_BURST_CMD_FLAGS		SMCHOST_CMD_FLAG_FAST
+#else
+#define ACPI_BURST_CMD_FLAGS		0
+#endif
+
+/* Host request as assembled by the ACPI peripheral callback */
+struct smchost_req {
+	uint8_t len;
+	/* Host command sequence number, see acpi_cmd_seq */
+	uint8_t seq;
+	uint8_t buf[SMCHOST_MAX_BUF_SIZE];
+};
+
+#define SMCHOST_REQ_QUEUE_SIZE		4U
+
+static struct smchost_req acpi_req;
+
+/* Host command left in input buffer until a deferred request fits */
+static bool acpi_req_held;
+
+/* Set while either ACPI callback or smchost thread consumes host input */
+static atomic_t acpi_service_busy;
+
+/* Incremented on every command byte from host. Host abandons any response
+ * not fully read when it sends a new command.
+ */
+static uint8_t acpi_cmd_seq;
+/* Command being handled and command the pending response belongs to */
+static uint8_t host_req_seq;
+static uint8_t host_res_seq;
+
+/* Registered host commands sorted by opcode, see SMCHOST_CMD_DEFINE */
+extern const struct smchost_cmd _smchost_cmd_list_start[];
+extern const struct smchost_cmd _smchost_cmd_list_end[];
+
+/* Complete host requests deferred to smchost thread */
+K_MSGQ_DEFINE(smchost_req_msgq, sizeof(struct smchost_req),
+	      SMCHOST_REQ_QUEUE_SIZE, 1);
+
 #ifdef CONFIG_SMCHOST_EVENT_DRIVEN_TASK
 /* Trigger from asynchronous events generated by other EC FW modules
  * of request from host.
@@ -80,33 +126,76 @@ void smchost_err_handler(void)
 #endif
 }
 
-static void smchost_acpi_handler(void)
+/* Service standard ACPI EC transactions directly from the peripheral
+ * callback. Anything else is deferred to smchost thread.
+ */
+static bool smchost_acpi_fast_path(struct smchost_req *req)
+{
+	const struct smchost_cmd *cmd = smchost_cmd_find(req->buf[0]);
+
+	if (!cmd || !(cmd->flags & SMCHOST_CMD_FLAG_FAST)) {
+		return false;
+	}
+
+	/* Commands replying to host are deferred to smchost thread instead
+	 * of polling output buffer when host has not read previous data.
+	 */
+	if ((req->buf[0] == EC_READ || req->buf[0] == EC_BURST) &&
+	    acpi_get_flag(ACPI_EC_0, ACPI_FLAG_OBF)) {
+		return false;
+	}
+
+	switch (req->buf[0]) {
+	case EC_READ:
+		acpi_read_ec(req->buf[1]);
+		break;
+	case EC_WRITE:
+		acpi_write_ec(req->buf[1], req->buf[2]);
+		break;
+	default:
+		cmd->handler();
+		break;
+	}
+
+	return true;
+}
+
+/* Consume all bytes available from host */
+static void smchost_acpi_consume(void)
 {
 	while (acpi_get_flag(ACPI_EC_0, ACPI_FLAG_IBF)) {
+		/* Do not consume next command while deferred requests queue is
+		 * full, host sees IBF set and waits until smchost thread drains
+		 * the queue instead of losing the command.
+		 */
+		if (acpi_get_flag(ACPI_EC_0, ACPI_FLAG_CD) &&
+		    !k_msgq_num_free_get(&smchost_req_msgq)) {
+			acpi_req_held = true;
+			return;
+		}
+
 		if (acpi_get_flag(ACPI_EC_0, ACPI_FLAG_CD)) {
 			/* It is a command */
-			host_req_len = 0;
+			acpi_req.len = 0;
+			acpi_req.seq = ++acpi_cmd_seq;
 
 			/* Read the command byte */
-			host_req[host_req_len] = acpi_read_idr(ACPI_EC_0);
-			LOG_DBG("Rcv EC cmd: %02X",
-				host_req[host_req_len]);
-
+			acpi_req.buf[0] = acpi_read_idr(ACPI_EC_0);
+			LOG_DBG("Rcv EC cmd: %02X", acpi_req.buf[0]);
 		} else {
 			/* It is data */
-			if (host_req[0] == EC_WRITE) {
-				generate_sci();
-			}
-
-			if (host_req_len < SMCHOST_MAX_BUF_SIZE) {
+			if (acpi_req.len < SMCHOST_MAX_BUF_SIZE) {
 				/* Read the data byte */
-				host_req[host_req_len] =
-				       acpi_read_idr(ACPI_EC_0);
+				acpi_req.buf[acpi_req.len] =
+					acpi_read_idr(ACPI_EC_0);
 				LOG_DBG("Host Rcvdata[%d] = %02X",
-					host_req_len, host_req[host_req_len]);
+					acpi_req.len,
+					acpi_req.buf[acpi_req.len]);
 			} else {
+				/* Discard so host is not left waiting on IBF */
+				acpi_read_idr(ACPI_EC_0);
 				LOG_WRN("Exceeds Rcvdata buf size! Ignored");
-				return;
+				continue;
 			}
 		}
 
@@ -114,21 +203,53 @@ static void smchost_acpi_handler(void)
 		 * to a ACPI read/write operation then ackwnowledge the OS
 		 * before performing the operation.
 		 */
-		if (host_req[0]) {
-			if ((host_req[0] == EC_READ) ||
-			    (host_req[0] == EC_WRITE)) {
+		if (acpi_req.buf[0]) {
+			if ((acpi_req.buf[0] == EC_READ) ||
+			    (acpi_req.buf[0] == EC_WRITE)) {
 				generate_sci();
 			}
 
-			if (smchost_req_length(host_req[0]) == host_req_len) {
-				LOG_INF("EC Command: %02X", host_req[0]);
-				smchost_cmd_handler(host_req[0]);
-				host_req[0] = 0;
+			if (smchost_req_length(acpi_req.buf[0]) ==
+			    acpi_req.len) {
+				acpi_req.len++;
+				if (!smchost_acpi_fast_path(&acpi_req) &&
+				    k_msgq_put(&smchost_req_msgq, &acpi_req,
+					       K_NO_WAIT)) {
+					/* Not expected, space is checked
+					 * before consuming the command.
+					 */
+					LOG_ERR("EC cmd %02X dropped",
+						acpi_req.buf[0]);
+				}
+				acpi_req.buf[0] = 0;
+				continue;
 			}
 		}
 
-		host_req_len++;
+		acpi_req.len++;
 	}
+}
+
+/* Called from both the peripheral callback and smchost thread. Only one
+ * context consumes host input at a time, so requests are handled in order
+ * while interrupts stay enabled. If the other context is busy it checks
+ * input buffer again once done.
+ */
+static void smchost_acpi_service(void)
+{
+	do {
+		if (atomic_set(&acpi_service_busy, 1)) {
+			return;
+		}
+
+		smchost_acpi_consume();
+		atomic_clear(&acpi_service_busy);
+	} while (acpi_get_flag(ACPI_EC_0, ACPI_FLAG_IBF) && !acpi_req_held);
+}
+
+static void smchost_acpi_handler(void)
+{
+	smchost_acpi_service();
 
 #ifdef CONFIG_SMCHOST_EVENT_DRIVEN_TASK
 	smchost_signal_request();
@@ -287,6 +408,7 @@ static inline int smchost_task_init(void)
 {
 	host_req_len = 0;
 	host_res_len = 0;
+	acpi_req.len = 0;
 
 #ifdef CONFIG_SMCHOST_EVENT_DRIVEN_TASK
 	k_sem_init(&acpi_lock, 0, 1);
@@ -339,14 +461,15 @@ static bool smchost_process_tasks(void)
 #ifdef EC_M_2_SSD_PLN
 	manage_pln_signal();
 #endif
+	service_host_requests();
+
 	if (acpi_burst_flag) {
 		proc_acpi_burst();
 	}
 
 	if (acpi_normal_flag) {
-		acpi_set_flag(ACPI_EC_0, ACPI_FLAG_ACPIBURST, 0);
 		acpi_normal_flag = 0;
-		generate_sci();
+		acpi_burst_exit();
 	}
 
 	/* Check for SMI/SCI pending and service any commands
@@ -358,7 +481,8 @@ static bool smchost_process_tasks(void)
 
 	handle_kb_backlight_pwm();
 
-	return (sci_pending() || pend_data);
+	return (sci_pending() || pend_data ||
+		k_msgq_num_used_get(&smchost_req_msgq));
 }
 
 void smchost_thread(void *p1, void *p2, void *p3)
@@ -389,31 +513,53 @@ void smchost_thread(void *p1, void *p2, void *p3)
 			/* Perform delay only in SCI pending notification */
 			if (sci_pending()) {
 				k_msleep(period);
+			} else if (host_res_len > 0) {
+				/* Let other tasks run while host reads response */
+				k_usleep(CONFIG_SMCHOST_HOST_RES_POLL_US);
 			}
 
 		} while (pend_processing);
 	}
 #else
 	while (true) {
-		/* Process tasks periodically*/
+		/* Process tasks periodically, sooner while host reads a
+		 * response
+		 */
 		smchost_process_tasks();
-		k_msleep(period);
+		if (host_res_len > 0) {
+			k_usleep(CONFIG_SMCHOST_HOST_RES_POLL_US);
+		} else {
+			k_msleep(period);
+		}
 	}
 #endif
 }
 
+/* Write next response byte if host read the previous one. Host reads do
+ * not generate an interrupt, so smchost thread checks again every
+ * CONFIG_SMCHOST_HOST_RES_POLL_US while a response is pending instead of
+ * waiting on output buffer.
+ */
+/* Drop rest of a response host no longer reads */
+static void host_res_check_abandoned(void)
+{
+	if (host_res_len > 0 && host_res_seq != acpi_cmd_seq) {
+		LOG_WRN("New host command, %d response bytes dropped",
+			host_res_len);
+		host_res_len = 0;
+		host_res_idx = 0;
+	}
+}
+
 static bool proc_host_send(void)
 {
-	if (host_res_len > 0) {
-		uint8_t flag = acpi_get_flag(ACPI_EC_0, ACPI_FLAG_OBF);
+	host_res_check_abandoned();
 
-		LOG_DBG("ACPI OBF flag %x", flag);
-		if (!flag) {
-			LOG_DBG("WriteODR %x",  host_res[host_res_idx]);
-			acpi_write_odr(ACPI_EC_0, host_res[host_res_idx]);
-			host_res_idx++;
-			host_res_len--;
-		}
+	if (host_res_len > 0 && !acpi_get_flag(ACPI_EC_0, ACPI_FLAG_OBF)) {
+		LOG_DBG("WriteODR %x",  host_res[host_res_idx]);
+		acpi_write_odr(ACPI_EC_0, host_res[host_res_idx]);
+		host_res_idx++;
+		host_res_len--;
 	}
 
 	return (host_res_len > 0);
@@ -429,6 +575,11 @@ void send_to_host(uint8_t *pdata, uint8_t Len)
 {
 	int i;
 
+	if (Len > SMCHOST_MAX_RES_SIZE) {
+		LOG_ERR("Response too long %d", Len);
+		return;
+	}
+
 	for (i = 0; i < Len; i++) {
 		host_res[i] = *(pdata + i);
 		LOG_DBG("Snd data: %02X",  host_res[i]);
@@ -436,6 +587,36 @@ void send_to_host(uint8_t *pdata, uint8_t Len)
 
 	host_res_len = Len;
 	host_res_idx = 0;
+	host_res_seq = host_req_seq;
+}
+
+static void service_host_requests(void)
+{
+	struct smchost_req req;
+
+	host_res_check_abandoned();
+
+	/* Next request is handled once host read the whole response */
+	while (host_res_len == 0 &&
+	       !k_msgq_get(&smchost_req_msgq, &req, K_NO_WAIT)) {
+		memcpys(host_req, req.buf, sizeof(host_req));
+		host_req_len = req.len;
+		host_req_seq = req.seq;
+
+		LOG_INF("EC Command: %02X", host_req[0]);
+		smchost_cmd_handler(host_req[0]);
+
+		/* Start streaming response right away */
+		proc_host_send();
+	}
+
+	/* Resume host input held back while the queue was full, there is no
+	 * further IBF interrupt for a byte already in the input buffer.
+	 */
+	if (acpi_req_held) {
+		acpi_req_held = false;
+		smchost_acpi_service();
+	}
 }
 
 static void service_system_acpi_cmds(void)
@@ -450,6 +631,7 @@ static void service_system_acpi_cmds(void)
 
 	/* Call the appropriate function from the table */
 	LOG_INF("Srcv ACPI CMD %x",  g_acpi_tbl.acpi_host_command);
+	host_req_seq = acpi_cmd_seq;
 	smchost_cmd_handler(g_acpi_tbl.acpi_host_command);
 
 	/* Clear the command after execution */
@@ -462,13 +644,12 @@ void host_cmd_default(uint8_t command)
 	LOG_WRN("%s: command 0x%X without handler", __func__, command);
 }
 
-static void acpi_read_ec(void)
+static void acpi_read_ec(uint8_t acpi_idx)
 {
-	uint8_t acpi_idx = host_req[1];
 	uint8_t data;
 
 	if (acpi_idx <= ACPI_MAX_INDEX) {
-		data = *((uint8_t *)&g_acpi_tbl + acpi_idx);
+		data = smc_acpi_host_read(acpi_idx);
 		LOG_DBG("ACPI ECR Data [%02x]: %02x", acpi_idx, data);
 	} else {
 		data = acpi_idx;
@@ -479,11 +660,8 @@ static void acpi_read_ec(void)
 	}
 }
 
-static void acpi_write_ec(void)
+static void acpi_write_ec(uint8_t acpi_idx, uint8_t data)
 {
-	uint8_t acpi_idx = host_req[1];
-	uint8_t data = host_req[2];
-
 	if (acpi_idx <= ACPI_MAX_INDEX) {
 		if (smc_is_acpi_offset_write_permitted(acpi_idx)) {
 			*((uint8_t *)&g_acpi_tbl + acpi_idx) = data;
@@ -500,24 +678,44 @@ uint8_t get_pltrst_signal_sts(void)
 	return pltrst_signal_sts;
 }
 
-#ifdef CONFIG_THERMAL_MANAGEMENT
-static void change_peci_access_mode(void)
+static void acpi_burst_exit(void)
 {
-#ifndef CONFIG_DEPRECATED_HW_STRAP_BASED_PECI_MODE_SEL
-	LOG_DBG("%s:Host peci_mode : %x", __func__, host_req[1]);
-	peci_access_mode_config(host_req[1]);
-#endif /* CONFIG_DEPRECATED_HW_STRAP_BASED_PECI_MODE_SEL */
+	acpi_set_flag(ACPI_EC_0, ACPI_FLAG_ACPIBURST, 0);
+	generate_sci();
 }
+
+#ifdef CONFIG_SMCHOST_ACPI_BURST_FAST_PATH
+/* OS did not disable burst mode within the budget, smchost thread leaves
+ * burst mode outside timer context.
+ */
+static void acpi_burst_expired(struct k_timer *timer)
+{
+	acpi_normal_flag = 1;
+#ifdef CONFIG_SMCHOST_EVENT_DRIVEN_TASK
+	smchost_signal_request();
+#endif
+}
+
+K_TIMER_DEFINE(acpi_burst_timer, acpi_burst_expired, NULL);
 #endif
 
 static void acpi_burst_ec(void)
 {
+#ifdef CONFIG_SMCHOST_ACPI_BURST_FAST_PATH
+	/* Acknowledge right away, following bytes are serviced as they
+	 * arrive from the ACPI peripheral callback.
+	 */
+	proc_acpi_burst();
+#else
 	acpi_burst_flag = 1;
+#endif
 }
 
 static void proc_acpi_burst(void)
 {
 	acpi_burst_flag = 0;
+	/* Drop budget expiry of a previous burst not yet serviced */
+	acpi_normal_flag = 0;
 	/* Tell host that we're burst */
 	acpi_set_flag(ACPI_EC_0, ACPI_FLAG_ACPIBURST, 1);
 	if (!acpi_send_byte(ACPI_EC_0, SCI_BURST_ACK)) {
@@ -525,19 +723,28 @@ static void proc_acpi_burst(void)
 		 * errors in OS
 		 */
 		generate_sci();
+#ifdef CONFIG_SMCHOST_ACPI_BURST_FAST_PATH
+		k_timer_start(&acpi_burst_timer,
+			      K_USEC(CONFIG_SMCHOST_ACPI_BURST_BUDGET_US),
+			      K_NO_WAIT);
+#endif
 		return;
 	} else {
 		LOG_ERR("Burst ACK failed");
 	}
 
 	/* Abort burst */
-	acpi_set_flag(ACPI_EC_0, ACPI_FLAG_ACPIBURST, 0);
-	generate_sci();
+	acpi_burst_exit();
 }
 
 static void acpi_normal_ec(void)
 {
+#ifdef CONFIG_SMCHOST_ACPI_BURST_FAST_PATH
+	k_timer_stop(&acpi_burst_timer);
+	acpi_burst_exit();
+#else
 	acpi_normal_flag = 1;
+#endif
 }
 
 static void acpi_query_ec(void)
@@ -579,130 +786,76 @@ static void write_acpi_space(void)
 	*((uint8_t *) &g_acpi_tbl + host_req[1]) = host_req[2];
 }
 
-static uint8_t smchost_req_length(uint8_t command)
+static void acpi_read_cmd(void)
 {
-	switch (command) {
-	case SMCHOST_PLN_CONFIG:
-	case SMCHOST_CS_LOW_PWR_MODE_SET:
-	case SMCHOST_SET_DSW_MODE:
-	case SMCHOST_PG3_SET_MODE:
-	case SMCHOST_ACPI_READ:
-	case SMCHOST_READ_ACPI_SPACE:
-	case SMCHOST_SET_PECI_ACCESS_MODE:
-	case SMCHOST_HID_BTN_SCI_CONTROL:
-#ifdef CONFIG_THERMAL_MANAGEMENT
-	case SMCHOST_BIOS_FAN_CONTROL:
-	case SMCHOST_SET_SHDWN_THRESHOLD:
-#endif
-		return 1;
+	acpi_read_ec(host_req[1]);
+}
+
+static void acpi_write_cmd(void)
+{
+	acpi_write_ec(host_req[1], host_req[2]);
+}
 
-	case SMCHOST_ACPI_WRITE:
-	case SMCHOST_WRITE_ACPI_SPACE:
-		return 2;
+const struct smchost_cmd *smchost_cmd_find(uint8_t opcode)
+{
+	const struct smchost_cmd *lo = _smchost_cmd_list_start;
+	const struct smchost_cmd *hi = _smchost_cmd_list_end;
+	const struct smchost_cmd *mid;
 
-	default:
-		return 0;
+	while (lo < hi) {
+		mid = lo + (hi - lo) / 2;
+		if (mid->opcode == opcode) {
+			return mid;
+		}
+
+		if (mid->opcode < opcode) {
+			lo = mid + 1;
+		} else {
+			hi = mid;
+		}
 	}
+
+	return NULL;
 }
 
-static void smchost_cmd_handler(uint8_t command)
+static uint8_t smchost_req_length(uint8_t command)
 {
-	switch (command) {
+	const struct smchost_cmd *cmd = smchost_cmd_find(command);
 
-	/* Handlers for commands 00h to 0Fh */
-#ifdef CONFIG_DEPRECATED_SMCHOST_CMD
-	case SMCHOST_QUERY_SYSTEM_STS:
-#endif
-	case SMCHOST_GET_PSR_SHUTDOWN_REASON:
-	case SMCHOST_GET_SMC_MODE:
-	case SMCHOST_GET_SWITCH_STS:
-	case SMCHOST_GET_FAB_ID:
-	case SMCHOST_GET_DOCK_STS:
-	case SMCHOST_READ_REVISION:
-	case SMCHOST_READ_PLAT_SIGNATURE:
-	case SMCHOST_HID_BTN_SCI_CONTROL:
-		smchost_cmd_info_handler(command);
-		break;
-	case SMCHOST_PLN_CONFIG:
-	case SMCHOST_CS_LOW_PWR_MODE_SET:
-	case SMCHOST_SET_DSW_MODE:
-	case SMCHOST_GET_DSW_MODE:
-	case SMCHOST_PG3_SET_MODE:
-	case SMCHOST_PG3_PROG_COUNTER:
-	case SMCHOST_CS_ENTRY:
-	case SMCHOST_CS_EXIT:
-	case SMCHOST_GET_LEGACY_WAKE_STS:
-	case SMCHOST_CLEAR_LEGACY_WAKE_STS:
-	case SMCHOST_SX_ENTRY:
-	case SMCHOST_SX_EXIT:
-	case SMCHOST_ENABLE_PWR_BTN_NOTIFY:
-	case SMCHOST_DISABLE_PWR_BTN_NOTIFY:
-	case SMCHOST_ENABLE_PWR_BTN_SW:
-	case SMCHOST_DISABLE_PWR_BTN_SW:
-	case SMCHOST_RESET_KSC:
-#ifdef CONFIG_DNX_EC_ASSISTED_TRIGGER_SMC
-	case SMCHOST_DNX_TRIGGER:
-	case SMCHOST_DNX_SET_STRAP:
-#endif
-		smchost_cmd_pm_handler(command);
-		break;
-
-#ifdef CONFIG_THERMAL_MANAGEMENT
-#ifdef CONFIG_DTT_SUPPORT_THERMALS
-	case SMCHOST_SET_TMP_THRESHOLD:
-#endif /* CONFIG_DTT_SUPPORT_THERMALS */
-	case SMCHOST_UPDATE_PWM:
-	case SMCHOST_BIOS_FAN_CONTROL:
-	case SMCHOST_SET_SHDWN_THRESHOLD:
-	case SMCHOST_SET_OS_ACTIVE_TRIP:
-	case SMCHOST_GET_HW_PERIPHERALS_STS:
-		smchost_cmd_thermal_handler(command);
-		break;
-#endif
-	/* Handlers for commands 80h to 8Fh */
-	case SMCHOST_ACPI_READ:
-		acpi_read_ec();
-		break;
-	case SMCHOST_ACPI_WRITE:
-		acpi_write_ec();
-		break;
-	case SMCHOST_ACPI_BURST_MODE:
-		acpi_burst_ec();
-		break;
-	case SMCHOST_ACPI_NORMAL_MODE:
-		acpi_normal_ec();
-		break;
-	case SMCHOST_ACPI_QUERY:
-		acpi_query_ec();
-		break;
+	return cmd ? cmd->req_len : 0;
+}
 
-	/* Handlers for commands A0h to AFh */
-	case SMCHOST_ENABLE_ACPI:
-		enable_acpi();
-		break;
-	case SMCHOST_DISABLE_ACPI:
-		disable_acpi();
-		break;
+static void smchost_cmd_handler(uint8_t command)
+{
+	const struct smchost_cmd *cmd = smchost_cmd_find(command);
 
-	/* Handler for command 3Ch */
-#ifdef CONFIG_THERMAL_MANAGEMENT
-	case SMCHOST_SET_PECI_ACCESS_MODE:
-		change_peci_access_mode();
-		break;
-#endif
-	/* Handlers for commands E0h to EFh */
-	case SMCHOST_READ_ACPI_SPACE:
-		read_acpi_space();
-		break;
-	case SMCHOST_WRITE_ACPI_SPACE:
-		write_acpi_space();
-		break;
-	default:
+	if (cmd) {
+		cmd->handler();
+	} else {
 		host_cmd_default(command);
-		break;
 	}
 }
 
+/* Handlers for commands 80h to 8Fh */
+SMCHOST_CMD_DEFINE(SMCHOST_ACPI_READ, acpi_read_cmd, 1,
+		   SMCHOST_CMD_FLAG_FAST);
+SMCHOST_CMD_DEFINE(SMCHOST_ACPI_WRITE, acpi_write_cmd, 2,
+		   SMCHOST_CMD_FLAG_FAST);
+SMCHOST_CMD_DEFINE(SMCHOST_ACPI_BURST_MODE, acpi_burst_ec, 0,
+		   ACPI_BURST_CMD_FLAGS);
+SMCHOST_CMD_DEFINE(SMCHOST_ACPI_NORMAL_MODE, acpi_normal_ec, 0,
+		   ACPI_BURST_CMD_FLAGS);
+SMCHOST_CMD_DEFINE(SMCHOST_ACPI_QUERY, acpi_query_ec, 0,
+		   SMCHOST_CMD_FLAG_FAST);
+
+/* Handlers for commands A0h to AFh */
+SMCHOST_CMD_DEFINE(SMCHOST_ENABLE_ACPI, enable_acpi, 0, 0);
+SMCHOST_CMD_DEFINE(SMCHOST_DISABLE_ACPI, disable_acpi, 0, 0);
+
+/* Handlers for commands E0h to EFh */
+SMCHOST_CMD_DEFINE(SMCHOST_READ_ACPI_SPACE, read_acpi_space, 1, 0);
+SMCHOST_CMD_DEFINE(SMCHOST_WRITE_ACPI_SPACE, write_acpi_space, 2, 0);
+
 static void handle_kb_backlight_pwm(void)
 {
 	if (prev_kb_bklt_pwm_duty != g_acpi_tbl.kb_bklt_pwm_duty) {
@@ -45,6 +45,8 @@
 
 /* EC identifier */
 #define SMCHOST_MAX_BUF_SIZE		10
+/* Largest response, sized for telemetry snapshot */
+#define SMCHOST_MAX_RES_SIZE		32
 
 /* Virtual Dock Status */
 #define VIRTUAL_DOCK_CONNECTED 0
@@ -124,7 +126,7 @@ void manage_pln_signal(void);
 uint8_t check_btn_sci_sts(uint8_t btn_sci_en_dis);
 
 extern uint8_t host_req[SMCHOST_MAX_BUF_SIZE];
-extern uint8_t host_res[SMCHOST_MAX_BUF_SIZE];
+extern uint8_t host_res[SMCHOST_MAX_RES_SIZE];
 extern uint8_t host_req_len;
 extern uint8_t host_res_len;
 extern uint8_t host_res_idx;
@@ -0,0 +1,409 @@
+/*
+ * Copyright (c) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <errno.h>
+#include <string.h>
+#include <zephyr.h>
+#include <logging/log.h>
+#include "acpi.h"
+#include "acpi_emul.h"
+#include "smc.h"
+#include "sci.h"
+#include "scicodes.h"
+#include "smchost.h"
+#include "smchost_commands.h"
+
+LOG_MODULE_DECLARE(smchost, CONFIG_SMCHOST_LOG_LEVEL);
+
+#define BENCH_STACK_SIZE		1024
+#define BENCH_START_DELAY_MS		2000
+/* Maximum time emulated host waits for each port access */
+#define BENCH_ACCESS_TIMEOUT_US		100000u
+#define BENCH_SMC_MODE_RES_LEN		4u
+/* Bytes of telemetry reply read before host moves on */
+#define BENCH_PARTIAL_READ_LEN		4u
+/* ACPI region read by OS within one burst */
+#define BENCH_BURST_READ_LEN		256u
+
+static uint32_t samples[CONFIG_SMCHOST_ACPI_BENCH_ITERATIONS];
+
+struct bench_case {
+	const char *name;
+	int (*run)(void);
+};
+
+static int wait_host_access(int (*access)(uint8_t *byte, bool cmd),
+			    uint8_t *byte, bool cmd)
+{
+	uint32_t timeout = k_us_to_cyc_ceil32(BENCH_ACCESS_TIMEOUT_US);
+	uint32_t start = k_cycle_get_32();
+	int ret;
+
+	do {
+		ret = access(byte, cmd);
+		if (!ret) {
+			return 0;
+		}
+
+		/* Let smchost thread consume or produce data */
+		k_yield();
+	} while ((k_cycle_get_32() - start) < timeout);
+
+	return -ETIMEDOUT;
+}
+
+static int host_write_access(uint8_t *byte, bool cmd)
+{
+	return acpi_emul_host_write(ACPI_EC_0, *byte, cmd);
+}
+
+static int host_read_access(uint8_t *byte, bool cmd)
+{
+	ARG_UNUSED(cmd);
+
+	return acpi_emul_host_read(ACPI_EC_0, byte);
+}
+
+static int sci_event_access(uint8_t *byte, bool cmd)
+{
+	ARG_UNUSED(byte);
+	ARG_UNUSED(cmd);
+
+	return (acpi_emul_host_status(ACPI_EC_0) & ACPI_FLAG_SCIEVENT) ?
+		0 : -EAGAIN;
+}
+
+static int host_write(uint8_t byte, bool cmd)
+{
+	return wait_host_access(host_write_access, &byte, cmd);
+}
+
+static int host_read(uint8_t *byte)
+{
+	return wait_host_access(host_read_access, byte, false);
+}
+
+static int ec_read(uint8_t idx, uint8_t *byte)
+{
+	int ret;
+
+	ret = host_write(EC_READ, true);
+	if (!ret) {
+		ret = host_write(idx, false);
+	}
+
+	if (!ret) {
+		ret = host_read(byte);
+	}
+
+	return ret;
+}
+
+static int bench_ec_read(void)
+{
+	uint8_t data;
+
+	return ec_read(SMC_ACPI_OFFSET(acpi_remote_temp), &data);
+}
+
+static int bench_ec_write(void)
+{
+	int ret;
+
+	ret = host_write(EC_WRITE, true);
+	if (!ret) {
+		ret = host_write(SMC_ACPI_OFFSET(acpi_passive_temp), false);
+	}
+
+	if (!ret) {
+		ret = host_write(g_acpi_tbl.acpi_passive_temp, false);
+	}
+
+	return ret;
+}
+
+static int bench_burst(void)
+{
+	uint8_t data;
+	int ret;
+
+	ret = host_write(EC_BURST, true);
+	if (!ret) {
+		ret = host_read(&data);
+	}
+
+	if (!ret && data != SCI_BURST_ACK) {
+		ret = -EIO;
+	}
+
+	if (!ret) {
+		ret = ec_read(SMC_ACPI_OFFSET(acpi_cpu_fan_rpm), &data);
+	}
+
+	if (!ret) {
+		ret = host_write(EC_NORM, true);
+	}
+
+	return ret;
+}
+
+#ifdef CONFIG_SMCHOST_ACPI_BURST_FAST_PATH
+static int bench_burst_read(void)
+{
+	uint8_t data;
+	int ret;
+
+	ret = host_write(EC_BURST, true);
+	if (!ret) {
+		ret = host_read(&data);
+	}
+
+	if (!ret && data != SCI_BURST_ACK) {
+		ret = -EIO;
+	}
+
+	for (int i = 0; !ret && i < BENCH_BURST_READ_LEN; i++) {
+		ret = ec_read(i, &data);
+	}
+
+	if (!ret) {
+		ret = host_write(EC_NORM, true);
+	}
+
+	return ret;
+}
+#endif
+
+static int bench_smc_cmd(void)
+{
+	uint8_t res[BENCH_SMC_MODE_RES_LEN];
+	int ret;
+
+	ret = host_write(SMCHOST_GET_SMC_MODE, true);
+	for (int i = 0; !ret && i < sizeof(res); i++) {
+		ret = host_read(&res[i]);
+	}
+
+	if (!ret && memcmp(res, "KSC", 3)) {
+		ret = -EIO;
+	}
+
+	return ret;
+}
+
+/* Multi-byte reply is complete when all bytes arrived intact and no
+ * further byte follows.
+ */
+static int bench_smc_telemetry(void)
+{
+	struct smchost_telemetry tlm;
+	uint8_t *res = (uint8_t *)&tlm;
+	int ret;
+
+	ret = host_write(SMCHOST_GET_TELEMETRY, true);
+	for (int i = 0; !ret && i < sizeof(tlm); i++) {
+		ret = host_read(&res[i]);
+	}
+
+	if (!ret && (tlm.len != sizeof(tlm) ||
+		     (acpi_emul_host_status(ACPI_EC_0) & ACPI_FLAG_OBF))) {
+		ret = -EIO;
+	}
+
+	return ret;
+}
+
+/* Host reads only part of a reply and sends next command. Rest of the
+ * first reply must not be mixed into the second one.
+ */
+static int bench_smc_partial_read(void)
+{
+	uint8_t res[BENCH_SMC_MODE_RES_LEN];
+	uint8_t stale;
+	int ret;
+
+	ret = host_write(SMCHOST_GET_TELEMETRY, true);
+	for (int i = 0; !ret && i < BENCH_PARTIAL_READ_LEN; i++) {
+		ret = host_read(&res[0]);
+	}
+
+	if (ret) {
+		return ret;
+	}
+
+	/* As OS drivers do, flush stale output before next command. EC must
+	 * not write again in between.
+	 */
+	k_sched_lock();
+	if (acpi_emul_host_status(ACPI_EC_0) & ACPI_FLAG_OBF) {
+		acpi_emul_host_read(ACPI_EC_0, &stale);
+	}
+
+	ret = acpi_emul_host_write(ACPI_EC_0, SMCHOST_GET_SMC_MODE, true);
+	k_sched_unlock();
+
+	for (int i = 0; !ret && i < sizeof(res); i++) {
+		ret = host_read(&res[i]);
+	}
+
+	if (!ret && memcmp(res, "KSC", 3)) {
+		ret = -EIO;
+	}
+
+	/* Nothing from first reply follows */
+	k_msleep(1);
+	if (!ret && (acpi_emul_host_status(ACPI_EC_0) & ACPI_FLAG_OBF)) {
+		ret = -EIO;
+	}
+
+	return ret;
+}
+
+static int bench_sci_query(void)
+{
+	uint8_t data;
+	int ret;
+
+	enqueue_sci(SCI_THERMAL);
+
+	ret = wait_host_access(sci_event_access, &data, false);
+	if (!ret) {
+		ret = host_write(EC_QUERY, true);
+	}
+
+	if (!ret) {
+		ret = host_read(&data);
+	}
+
+	return ret;
+}
+
+/* Every registered command is found by its opcode and nothing else is.
+ * Section order must match opcode order for lookup to work.
+ */
+static int bench_cmd_dispatch(void)
+{
+	const struct smchost_cmd *found;
+	int prev = -1;
+	int cnt = 0;
+
+	STRUCT_SECTION_FOREACH(smchost_cmd, cmd) {
+		if (cmd->opcode <= prev) {
+			LOG_ERR("Command %02X out of order", cmd->opcode);
+			return -EIO;
+		}
+
+		prev = cmd->opcode;
+		cnt++;
+	}
+
+	for (int opcode = 0; opcode <= UINT8_MAX; opcode++) {
+		found = smchost_cmd_find(opcode);
+		if (!found) {
+			continue;
+		}
+
+		if (found->opcode != opcode) {
+			return -EIO;
+		}
+
+		cnt--;
+	}
+
+	return cnt ? -EIO : 0;
+}
+
+static const struct bench_case bench_cases[] = {
+	{ "CMD_DISPATCH", bench_cmd_dispatch },
+	{ "EC_READ", bench_ec_read },
+	{ "EC_WRITE", bench_ec_write },
+	{ "BURST", bench_burst },
+#ifdef CONFIG_SMCHOST_ACPI_BURST_FAST_PATH
+	{ "BURST_READ_256", bench_burst_read },
+#endif
+	{ "SMC_CMD", bench_smc_cmd },
+	{ "SMC_TELEMETRY", bench_smc_telemetry },
+	{ "SMC_PARTIAL_READ", bench_smc_partial_read },
+	{ "SCI_QUERY", bench_sci_query },
+};
+
+static void sort_samples(uint32_t *buf, uint16_t len)
+{
+	for (uint16_t i = 1; i < len; i++) {
+		uint32_t val = buf[i];
+		int j = i - 1;
+
+		while (j >= 0 && buf[j] > val) {
+			buf[j + 1] = buf[j];
+			j--;
+		}
+
+		buf[j + 1] = val;
+	}
+}
+
+static uint32_t percentile(const uint32_t *buf, uint16_t len, uint8_t pct)
+{
+	return k_cyc_to_us_floor32(buf[((len - 1) * pct) / 100]);
+}
+
+static void bench_run(const struct bench_case *bc)
+{
+	uint32_t total = 0;
+	uint16_t failed = 0;
+	uint16_t cnt = 0;
+	uint32_t start;
+	uint32_t total_us;
+
+	for (int i = 0; i < ARRAY_SIZE(samples); i++) {
+		start = k_cycle_get_32();
+		if (bc->run()) {
+			failed++;
+			continue;
+		}
+
+		samples[cnt] = k_cycle_get_32() - start;
+		total += samples[cnt];
+		cnt++;
+	}
+
+	if (cnt == 0) {
+		LOG_WRN("%s: all %d iterations failed", bc->name, failed);
+		return;
+	}
+
+	sort_samples(samples, cnt);
+	total_us = MAX(k_cyc_to_us_floor32(total), 1);
+
+	LOG_INF("%s: %d ops/s p50 %d us p90 %d us p99 %d us max %d us fail %d",
+		bc->name, (uint32_t)((uint64_t)cnt * USEC_PER_SEC / total_us),
+		percentile(samples, cnt, 50), percentile(samples, cnt, 90),
+		percentile(samples, cnt, 99), percentile(samples, cnt, 100),
+		failed);
+}
+
+static void smchost_bench_thread(void *p1, void *p2, void *p3)
+{
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	/* SCI query cycles require ACPI mode */
+	if (host_write(SMCHOST_ENABLE_ACPI, true)) {
+		LOG_WRN("Unable to enable ACPI mode");
+	}
+
+	for (int i = 0; i < ARRAY_SIZE(bench_cases); i++) {
+		bench_run(&bench_cases[i]);
+	}
+}
+
+/* Emulated host only runs while firmware tasks are idle, so latency is the
+ * time EC takes to react to each host access.
+ */
+K_THREAD_DEFINE(smchost_bench_thrd_id, BENCH_STACK_SIZE, smchost_bench_thread,
+		NULL, NULL, NULL, K_LOWEST_APPLICATION_THREAD_PRIO, 0,
+		BENCH_START_DELAY_MS);
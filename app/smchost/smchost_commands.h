@@ -17,6 +17,10 @@
 #define SMCHOST_GET_PSR_SHUTDOWN_REASON 0x0C
 #define SMCHOST_GET_FAB_ID		0x0D
 #define SMCHOST_PLN_CONFIG		0x0F
+#define SMCHOST_GET_OOB_STATS		0x10
+#define SMCHOST_GET_TELEMETRY		0x11
+#define SMCHOST_GET_SCI_STATS		0x12
+#define SMCHOST_GET_PWRSEQ_TIMING	0x1E
 #define SMCHOST_ENABLE_PWR_BTN_SW	0x23
 #define SMCHOST_DISABLE_PWR_BTN_SW	0x24
 #define SMCHOST_CS_LOW_PWR_MODE_SET	0x27
@@ -49,16 +53,27 @@
 #define SMCHOST_READ_ACPI_SPACE		0xEA
 #define SMCHOST_WRITE_ACPI_SPACE	0xEB
 #define SMCHOST_RESET_KSC		0xFF
+#ifdef CONFIG_BOOT_PROFILER
+#define SMCHOST_GET_BOOT_PROFILE	0x1C
+#endif
+#ifdef CONFIG_PWRSEQ_JOURNAL
+#define SMCHOST_GET_PWRSEQ_JOURNAL	0x1D
+#endif
 #ifdef CONFIG_DEPRECATED_SMCHOST_CMD
 #define SMCHOST_QUERY_SYSTEM_STS	0x06
 #endif
 #ifdef CONFIG_THERMAL_MANAGEMENT
 #define SMCHOST_GET_HW_PERIPHERALS_STS	0x0B
+#define SMCHOST_GET_FAN_INFO		0x19
 #define SMCHOST_UPDATE_PWM		0x1A
+#ifdef CONFIG_THERMAL_HISTORY
+#define SMCHOST_GET_THERM_HISTORY	0x1B
+#endif
 #define SMCHOST_SET_OS_ACTIVE_TRIP	0x39
 #define SMCHOST_SET_PECI_ACCESS_MODE	0x3C
 #ifdef CONFIG_DTT_SUPPORT_THERMALS
 #define SMCHOST_SET_TMP_THRESHOLD	0x4A
+#define SMCHOST_DTT_GET_EVENTS		0x4B
 #endif /* CONFIG_DTT_SUPPORT_THERMALS */
 #define SMCHOST_SET_SHDWN_THRESHOLD	0x58
 #define SMCHOST_BIOS_FAN_CONTROL	0xFE
@@ -7,29 +7,101 @@
 #ifndef __SMCHOST_EXTENDED_H__
 #define __SMCHOST_EXTENDED_H__
 
+#include <zephyr.h>
 
 /**
- * @brief Handle extended SMC commands to retrieve EC information.
+ * @brief Handler for a SMC host command.
  *
- * @param command identifier for the operation requested.
+ * Request data bytes are available in host_req, response is sent using
+ * send_to_host.
  */
-void smchost_cmd_info_handler(uint8_t command);
+typedef void (*smchost_cmd_handler_t)(void);
+
+/* Command is serviced directly from ACPI peripheral callback */
+#define SMCHOST_CMD_FLAG_FAST		BIT(0)
+
+/**
+ * @brief SMC host command descriptor.
+ *
+ * @param handler routine to execute the command.
+ * @param opcode command identifier.
+ * @param req_len number of data bytes following the command byte.
+ * @param flags command attributes.
+ */
+struct smchost_cmd {
+	smchost_cmd_handler_t handler;
+	uint8_t opcode;
+	uint8_t req_len;
+	uint8_t flags;
+};
+
+/**
+ * @brief Register a SMC host command.
+ *
+ * Descriptors are placed in a read-only iterable linker section, named and
+ * therefore sorted by opcode value. Registering an opcode twice, even under
+ * different names, fails to link. Opcodes must be two digit upper case hex
+ * literals, e.g. 0x1C, for name order to match numeric order.
+ *
+ * @param _opcode command identifier from smchost_commands.h.
+ * @param _handler routine to execute the command.
+ * @param _req_len number of data bytes following the command byte.
+ * @param _flags command attributes.
+ */
+#define SMCHOST_CMD_DEFINE(_opcode, _handler, _req_len, _flags)		\
+	BUILD_ASSERT((_opcode) <= UINT8_MAX, "Invalid command opcode");	\
+	BUILD_ASSERT((_req_len) < SMCHOST_MAX_BUF_SIZE,			\
+		     "Request does not fit host buffer");		\
+	const STRUCT_SECTION_ITERABLE(smchost_cmd,			\
+				      UTIL_CAT(smchost_cmd_, _opcode)) = { \
+		.handler = _handler,					\
+		.opcode = _opcode,					\
+		.req_len = _req_len,					\
+		.flags = _flags,					\
+	}
 
 /**
- * @brief Handle extended SMC commands for power management operations.
+ * @brief Find a registered SMC host command.
+ *
+ * Binary search over the sorted command section, no RAM table is built.
+ *
+ * @param opcode command identifier.
  *
- * @param command identifier for the operation requested.
+ * @retval command descriptor or NULL if opcode is not registered.
  */
-void smchost_cmd_pm_handler(uint8_t command);
+const struct smchost_cmd *smchost_cmd_find(uint8_t opcode);
+
+/* Telemetry snapshot layout version, bump on any layout change */
+#define SMCHOST_TELEMETRY_VERSION	1u
 
-#ifdef CONFIG_THERMAL_MANAGEMENT
 /**
- * @brief Handle extended SMC commands for thermal management.
+ * @brief Telemetry snapshot returned to host in a single transaction.
  *
- * @param command identifier for the operation requested.
+ * Multi-byte fields are little endian. Temperatures and sensor readings
+ * use the same units as their ACPI region counterparts.
+ */
+struct smchost_telemetry {
+	uint8_t version;
+	uint8_t len;
+	uint8_t cpu_temp;
+	uint8_t gpu_temp;
+	uint8_t pch_temp;
+	uint8_t cpu_pch_max_temp;
+	uint16_t cpu_dts;
+	uint16_t therm_sen[5];
+	uint16_t therm_snsr_sts;
+	uint16_t cpu_fan_rpm;
+	uint8_t cpu_fan_duty;
+	uint8_t pwr_state;
+	uint8_t wake_sts;
+	uint8_t acpi_flags;
+	uint8_t acpi_flags2;
+} __packed;
+
+/**
+ * @brief Get legacy wake status bits reported to host.
  */
-void smchost_cmd_thermal_handler(uint8_t command);
-#endif
+uint8_t smchost_legacy_wake_status(void);
 
 /**
  * @brief Handle power button events.
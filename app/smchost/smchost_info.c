@@ -5,16 +5,23 @@
  */
 
 #include <logging/log.h>
+#include <sys/byteorder.h>
 #include "board.h"
 #include "board_config.h"
 #include "smc.h"
 #include "smchost.h"
 #include "smchost_commands.h"
+#include "sci.h"
 #include "pwrplane.h"
 
 #include "espi_hub.h"
+#include "espioob_mngr.h"
 #include "system.h"
 #include "flashhdr.h"
+#include "memops.h"
+#ifdef CONFIG_THERMAL_MANAGEMENT
+#include "thermalmgmt.h"
+#endif
 
 LOG_MODULE_DECLARE(smchost, CONFIG_SMCHOST_LOG_LEVEL);
 
@@ -170,40 +177,162 @@ static void get_shutdown_reason(void)
 	send_to_host((uint8_t *)&shutdown_status, sizeof(shutdown_status));
 }
 
+/* OOB statistics request byte encoding */
+#define OOB_STATS_MASTER_MASK		0x1F
+#define OOB_STATS_PAGE_POS		6
+#define OOB_STATS_CLEAR_POS		7
 
-void smchost_cmd_info_handler(uint8_t command)
+/* Round-trip times are reported in 100us units */
+#define OOB_STATS_RTT_UNIT_US		100
+
+static inline uint16_t sat_u16(uint32_t val)
 {
-	switch (command) {
-#ifdef CONFIG_DEPRECATED_SMCHOST_CMD
-	case SMCHOST_QUERY_SYSTEM_STS:
-		query_system_status();
-		break;
-#endif
-	case SMCHOST_GET_PSR_SHUTDOWN_REASON:
-		get_shutdown_reason();
-		/* Clear shutodown reason */
-		set_shutdown_reason(SHUTDOWN_REASON_DEFAULT);
-		break;
-	case SMCHOST_GET_SMC_MODE:
-		smc_mode();
-		break;
-	case SMCHOST_GET_SWITCH_STS:
-		get_switch_status();
-		break;
-	case SMCHOST_GET_FAB_ID:
-		smc_get_fab_id();
-		break;
-	case SMCHOST_READ_PLAT_SIGNATURE:
-		read_platform_signature();
-		break;
-	case SMCHOST_READ_REVISION:
-		read_revision();
-		break;
-	case SMCHOST_HID_BTN_SCI_CONTROL:
-		btn_sci_cntrl();
-		break;
-	default:
-		LOG_WRN("%s: command 0x%X without handler", __func__, command);
-		break;
+	return (uint16_t)MIN(val, UINT16_MAX);
+}
+
+static inline uint8_t sat_u8(uint32_t val)
+{
+	return (uint8_t)MIN(val, UINT8_MAX);
+}
+
+/**
+ * @brief Returns eSPI OOB channel statistics for a master.
+ *
+ * Input: bits[4:0] OOB master address (OOB_MASTER_ADDR_*), bit 5 reserved,
+ * bit 6 page, bit 7 clear all statistics after read.
+ * Page 0: tx(2), rx(2), timeouts(1), late responses(1),
+ *         max rtt(2), avg rtt(2). RTT in 100us units.
+ * Page 1: tx bytes(4), rx bytes(4), tx errors(1), rx overflows(1).
+ */
+static void get_oob_stats(void)
+{
+	struct oob_stats stats;
+	uint8_t res[10] = {0};
+	uint8_t master = host_req[1] & OOB_STATS_MASTER_MASK;
+	uint16_t val;
+
+	if (oob_get_stats(master, &stats)) {
+		LOG_WRN("Invalid OOB master %x", master);
+		send_to_host(res, sizeof(res));
+		return;
+	}
+
+	if (host_req[1] & BIT(OOB_STATS_PAGE_POS)) {
+		sys_put_le32(stats.tx_bytes, &res[0]);
+		sys_put_le32(stats.rx_bytes, &res[4]);
+		res[8] = sat_u8(stats.tx_err);
+		res[9] = sat_u8(stats.rx_nobufs);
+	} else {
+		sys_put_le16(sat_u16(stats.tx), &res[0]);
+		sys_put_le16(sat_u16(stats.rx), &res[2]);
+		res[4] = sat_u8(stats.timeouts);
+		res[5] = sat_u8(stats.late_rsp);
+		val = sat_u16(stats.max_rtt_us / OOB_STATS_RTT_UNIT_US);
+		sys_put_le16(val, &res[6]);
+		val = sat_u16(stats.avg_rtt_us / OOB_STATS_RTT_UNIT_US);
+		sys_put_le16(val, &res[8]);
 	}
+
+	if (host_req[1] & BIT(OOB_STATS_CLEAR_POS)) {
+		oob_reset_stats();
+	}
+
+	send_to_host(res, sizeof(res));
 }
+
+/* ACPI region range holding all telemetry fields */
+#define TLM_ACPI_START		SMC_ACPI_OFFSET(acpi_remote_temp)
+#define TLM_ACPI_END		(SMC_ACPI_OFFSET(acpi_sen5) + sizeof(uint16_t))
+#define TLM_ACPI_FIELD(field)	(&tlm_acpi[SMC_ACPI_OFFSET(field) - \
+					   TLM_ACPI_START])
+
+BUILD_ASSERT(TLM_ACPI_END - TLM_ACPI_START <= UINT8_MAX,
+	     "Telemetry ACPI range too large for a single snapshot");
+
+static uint8_t tlm_acpi[TLM_ACPI_END - TLM_ACPI_START];
+
+/**
+ * @brief Returns a telemetry snapshot in a single transaction.
+ *
+ * Replaces multiple EC_READ of ACPI region fields. Fields are copied from a
+ * single ACPI region snapshot so host gets a coherent view. Host should
+ * check version and length before parsing, see struct smchost_telemetry.
+ */
+static void get_telemetry(void)
+{
+	struct smchost_telemetry tlm;
+	uint8_t fan_duty = 0;
+
+#ifdef CONFIG_THERMAL_MANAGEMENT
+	fan_duty = thermalmgmt_get_fan_duty(FAN_CPU);
+#endif
+	tlm.version = SMCHOST_TELEMETRY_VERSION;
+	tlm.len = sizeof(tlm);
+	tlm.pwr_state = pwrseq_system_state();
+
+	smc_acpi_snapshot(TLM_ACPI_START, tlm_acpi, sizeof(tlm_acpi));
+
+	/* ACPI region and telemetry multi-byte fields are little endian */
+	tlm.cpu_temp = *TLM_ACPI_FIELD(acpi_remote_temp);
+	tlm.gpu_temp = *TLM_ACPI_FIELD(acpi_gpu_temp);
+	tlm.pch_temp = *TLM_ACPI_FIELD(acpi_pch_dts_temp);
+	tlm.cpu_pch_max_temp = *TLM_ACPI_FIELD(acpi_cpu_pch_max_temp);
+	memcpys(&tlm.cpu_dts, TLM_ACPI_FIELD(acpi_cpu_dts),
+		sizeof(tlm.cpu_dts));
+	memcpys(tlm.therm_sen, TLM_ACPI_FIELD(acpi_sen1),
+		sizeof(tlm.therm_sen));
+	memcpys(&tlm.therm_snsr_sts, TLM_ACPI_FIELD(acpi_therm_snsr_sts),
+		sizeof(tlm.therm_snsr_sts));
+	memcpys(&tlm.cpu_fan_rpm, TLM_ACPI_FIELD(acpi_cpu_fan_rpm),
+		sizeof(tlm.cpu_fan_rpm));
+	tlm.cpu_fan_duty = fan_duty;
+	tlm.wake_sts = smchost_legacy_wake_status();
+	tlm.acpi_flags = *TLM_ACPI_FIELD(acpi_flags);
+	tlm.acpi_flags2 = *TLM_ACPI_FIELD(acpi_flags2);
+
+	send_to_host((uint8_t *)&tlm, sizeof(tlm));
+}
+
+BUILD_ASSERT(sizeof(struct smchost_telemetry) <= SMCHOST_MAX_RES_SIZE,
+	     "Telemetry snapshot does not fit host buffer");
+
+/**
+ * @brief Returns SCI queue statistics.
+ *
+ * Output: queued(4), coalesced(4), dropped(4), little endian.
+ */
+static void get_sci_stats(void)
+{
+	struct sci_stats stats;
+	uint8_t res[12];
+
+	sci_get_stats(&stats);
+	sys_put_le32(stats.queued, &res[0]);
+	sys_put_le32(stats.coalesced, &res[4]);
+	sys_put_le32(stats.dropped, &res[8]);
+
+	send_to_host(res, sizeof(res));
+}
+
+static void clear_shutdown_reason(void)
+{
+	get_shutdown_reason();
+	/* Clear shutodown reason */
+	set_shutdown_reason(SHUTDOWN_REASON_DEFAULT);
+}
+
+#ifdef CONFIG_DEPRECATED_SMCHOST_CMD
+SMCHOST_CMD_DEFINE(SMCHOST_QUERY_SYSTEM_STS, query_system_status, 0, 0);
+#endif
+SMCHOST_CMD_DEFINE(SMCHOST_GET_PSR_SHUTDOWN_REASON, clear_shutdown_reason,
+		   0, 0);
+SMCHOST_CMD_DEFINE(SMCHOST_GET_SMC_MODE, smc_mode, 0, 0);
+SMCHOST_CMD_DEFINE(SMCHOST_GET_SWITCH_STS, get_switch_status, 0, 0);
+SMCHOST_CMD_DEFINE(SMCHOST_GET_FAB_ID, smc_get_fab_id, 0, 0);
+SMCHOST_CMD_DEFINE(SMCHOST_READ_PLAT_SIGNATURE, read_platform_signature,
+		   0, 0);
+SMCHOST_CMD_DEFINE(SMCHOST_READ_REVISION, read_revision, 0, 0);
+SMCHOST_CMD_DEFINE(SMCHOST_HID_BTN_SCI_CONTROL, btn_sci_cntrl, 1, 0);
+SMCHOST_CMD_DEFINE(SMCHOST_GET_OOB_STATS, get_oob_stats, 1, 0);
+SMCHOST_CMD_DEFINE(SMCHOST_GET_TELEMETRY, get_telemetry, 0, 0);
+SMCHOST_CMD_DEFINE(SMCHOST_GET_SCI_STATS, get_sci_stats, 0, 0);
@@ -6,6 +6,7 @@
 
 #include <logging/log.h>
 #include <device.h>
+#include <sys/byteorder.h>
 #include "port80display.h"
 #include "board.h"
 #include "board_config.h"
@@ -16,6 +17,7 @@
 #include "acpi.h"
 #include "pwrplane.h"
 #include "pwrseq_utils.h"
+#include "pwrseq_steps.h"
 #include "dswmode.h"
 #include "pseudog3.h"
 #include "kbchost.h"
@@ -23,6 +25,13 @@
 #ifdef CONFIG_DNX_EC_ASSISTED_TRIGGER_SMC
 #include "dnx_ec_assisted_trigger.h"
 #endif
+#ifdef CONFIG_BOOT_PROFILER
+#include "boot_prof.h"
+#endif
+#ifdef CONFIG_PWRSEQ_JOURNAL
+#include "memops.h"
+#include "pwrseq_journal.h"
+#endif
 LOG_MODULE_DECLARE(smchost, CONFIG_SMCHOST_LOG_LEVEL);
 
 static bool pwrbtn_notify;
@@ -241,6 +250,11 @@ static void cs_exit(void)
 #endif
 }
 
+uint8_t smchost_legacy_wake_status(void)
+{
+	return legacy_wake_status;
+}
+
 static void get_legacy_wake_sts(void)
 {
 	send_to_host(&legacy_wake_status, 1);
@@ -251,73 +265,219 @@ static void clear_legacy_wake_sts(void)
 	legacy_wake_status = 0;
 }
 
-void smchost_cmd_pm_handler(uint8_t command)
+static void enable_pwrbtn_notify(void)
 {
-	switch (command) {
-	case SMCHOST_PLN_CONFIG:
-		config_ssd_pln();
-		break;
-	case SMCHOST_ENABLE_PWR_BTN_NOTIFY:
-		pwrbtn_notify = true;
-		break;
-	case SMCHOST_DISABLE_PWR_BTN_NOTIFY:
-		pwrbtn_notify = false;
-		break;
-	case SMCHOST_ENABLE_PWR_BTN_SW:
-		g_pwrflags.pwr_sw_enabled = 1;
-		break;
-	case SMCHOST_DISABLE_PWR_BTN_SW:
-		g_pwrflags.pwr_sw_enabled = 0;
-		break;
-	case SMCHOST_GET_LEGACY_WAKE_STS:
-		get_legacy_wake_sts();
-		break;
-	case SMCHOST_CLEAR_LEGACY_WAKE_STS:
-		clear_legacy_wake_sts();
-		break;
-	case SMCHOST_SX_ENTRY:
-		sx_entry();
-		break;
-	case SMCHOST_SX_EXIT:
-		sx_exit();
-		break;
-	case SMCHOST_SET_DSW_MODE:
-		change_dsw_mode();
-		break;
-	case SMCHOST_GET_DSW_MODE:
-		retrieve_dsw_mode();
-		break;
-	case SMCHOST_PG3_SET_MODE:
-		change_pg3_mode();
-		break;
-	case SMCHOST_PG3_PROG_COUNTER:
-		pg3_prog_counter();
-		break;
-	case SMCHOST_CS_LOW_PWR_MODE_SET:
-		enable_cs_lpm_mode();
-		break;
-	case SMCHOST_CS_ENTRY:
-		cs_entry();
-		break;
-	case SMCHOST_CS_EXIT:
-		cs_exit();
-		break;
+	pwrbtn_notify = true;
+}
+
+static void disable_pwrbtn_notify(void)
+{
+	pwrbtn_notify = false;
+}
+
+static void enable_pwrbtn_sw(void)
+{
+	g_pwrflags.pwr_sw_enabled = 1;
+}
+
+static void disable_pwrbtn_sw(void)
+{
+	g_pwrflags.pwr_sw_enabled = 0;
+}
+
 #ifdef CONFIG_DNX_EC_ASSISTED_TRIGGER_SMC
-	/* Set DnX strap and trigger cold restart, requires eSPI OOB support */
-	case SMCHOST_DNX_TRIGGER:
-		dnx_soc_handshake();
-		dnx_ec_assisted_restart();
-		break;
-	/* Set DnX strap only, requires manual restart */
-	case SMCHOST_DNX_SET_STRAP:
-		dnx_soc_handshake();
-		break;
+/* Set DnX strap and trigger cold restart, requires eSPI OOB support */
+static void dnx_trigger(void)
+{
+	dnx_soc_handshake();
+	dnx_ec_assisted_restart();
+}
+
+/* Set DnX strap only, requires manual restart */
+static void dnx_set_strap(void)
+{
+	dnx_soc_handshake();
+}
 #endif /* CONFIG_DNX_EC_ASSISTED_TRIGGER_SMC */
-	case SMCHOST_RESET_KSC:
-		ec_reset();
-		break;
-	default:
-		LOG_WRN("%s: command 0x%X without handler", __func__, command);
-		break;
+
+#ifdef CONFIG_BOOT_PROFILER
+/* Boot profile response header size and timestamps per transaction */
+#define BOOT_PROF_RES_HDR_SIZE	8
+#define BOOT_PROF_RES_MARKS	((SMCHOST_MAX_RES_SIZE - \
+				  BOOT_PROF_RES_HDR_SIZE) / sizeof(uint32_t))
+#define BOOT_PROF_RES_CHUNKS	ceiling_fraction(BOOT_PROF_NUM_MARKS, \
+						 BOOT_PROF_RES_MARKS)
+
+/**
+ * @brief Returns last S5/S3 to S0 boot profile, see struct boot_prof_rec.
+ *
+ * Input
+ *  Byte 0: chunk index, every chunk holds 6 timestamps
+ * Output
+ *  Byte 0: transition type
+ *  Byte 1: record state
+ *  Byte 2 - 3: number of transitions profiled
+ *  Byte 4 - 5: signal polling granularity in us
+ *  Byte 6: number of timestamps in record, 0 if chunk index is invalid
+ *  Byte 7: index of first timestamp in chunk
+ *  Byte 8 - 31: timestamps in us, 0xFFFFFFFF if event did not occur
+ */
+static void get_boot_profile(void)
+{
+	struct boot_prof_rec rec;
+	uint8_t res[SMCHOST_MAX_RES_SIZE] = {0};
+	uint16_t first;
+	uint8_t i;
+
+	if (host_req[1] >= BOOT_PROF_RES_CHUNKS) {
+		LOG_WRN("Invalid boot profile chunk %d", host_req[1]);
+		send_to_host(res, sizeof(res));
+		return;
+	}
+
+	first = host_req[1] * BOOT_PROF_RES_MARKS;
+	boot_prof_get(&rec);
+
+	res[0] = rec.type;
+	res[1] = rec.state;
+	sys_put_le16(rec.count, &res[2]);
+	sys_put_le16(rec.poll_us, &res[4]);
+	res[6] = BOOT_PROF_NUM_MARKS;
+	res[7] = first;
+	for (i = 0; i < BOOT_PROF_RES_MARKS; i++) {
+		sys_put_le32((first + i < BOOT_PROF_NUM_MARKS) ?
+			     rec.ts[first + i] : BOOT_PROF_NO_TS,
+			     &res[BOOT_PROF_RES_HDR_SIZE + i * sizeof(uint32_t)]);
 	}
+
+	send_to_host(res, sizeof(res));
 }
+#endif
+
+#ifdef CONFIG_PWRSEQ_JOURNAL
+/* Power sequencing journal response header size */
+#define PWRSEQ_JOURNAL_RES_HDR_SIZE	3
+
+/**
+ * @brief Returns a power sequencing journal entry, see struct
+ * pwrseq_journal_entry.
+ *
+ * Input
+ *  Byte 0: entry index, 0 is the most recent entry
+ * Output
+ *  Byte 0: number of entries in EEPROM
+ *  Byte 1: number of events not written to EEPROM yet
+ *  Byte 2: 1 if entry is valid, 0 otherwise
+ *  Byte 3 - 18: entry
+ */
+static void get_pwrseq_journal(void)
+{
+	struct pwrseq_journal_entry entry;
+	uint8_t res[PWRSEQ_JOURNAL_RES_HDR_SIZE + sizeof(entry)] = {0};
+	int ret;
+
+	res[0] = pwrseq_journal_count(&res[1]);
+	ret = pwrseq_journal_read(host_req[1], &entry);
+	if (ret) {
+		LOG_WRN("Invalid journal entry %d: %d", host_req[1], ret);
+	} else {
+		res[2] = 1;
+		memcpys(&res[PWRSEQ_JOURNAL_RES_HDR_SIZE], &entry,
+			sizeof(entry));
+	}
+
+	send_to_host(res, sizeof(res));
+}
+#endif
+
+/* Power sequence timing response header size and steps per transaction */
+#define PWRSEQ_TIMING_RES_HDR_SIZE	8
+#define PWRSEQ_TIMING_RES_STEPS		((SMCHOST_MAX_RES_SIZE - \
+					  PWRSEQ_TIMING_RES_HDR_SIZE) / \
+					 sizeof(uint32_t))
+
+static struct pwrseq_seq * const timing_seqs[] = {
+	&pwrseq_power_on,
+	&pwrseq_resume,
+	&pwrseq_power_off,
+	&pwrseq_suspend,
+	&pwrseq_slp_check,
+};
+
+/**
+ * @brief Returns per-step timing of last execution of a power sequence.
+ *
+ * Input
+ *  Byte 0: sequence, 0 power on, 1 resume, 2 power off, 3 suspend,
+ *          4 SLP check
+ *  Byte 1: index of first step
+ * Output
+ *  Byte 0: number of steps in sequence, 0 if sequence is invalid
+ *  Byte 1: failed step or 0xFF
+ *  Byte 2: index of first step in response
+ *  Byte 3: reserved
+ *  Byte 4 - 7: total sequence time in us
+ *  Byte 8 - 31: step times in us, 0 if step was not executed
+ */
+static void get_pwrseq_timing(void)
+{
+	const struct pwrseq_seq *seq;
+	uint8_t res[SMCHOST_MAX_RES_SIZE] = {0};
+	uint32_t elapsed_us;
+	uint8_t i;
+
+	if (host_req[1] >= ARRAY_SIZE(timing_seqs)) {
+		LOG_WRN("Invalid power sequence %d", host_req[1]);
+		send_to_host(res, sizeof(res));
+		return;
+	}
+
+	seq = timing_seqs[host_req[1]];
+	res[0] = seq->num_steps;
+	res[1] = seq->failed_step;
+	res[2] = host_req[2];
+	sys_put_le32(seq->total_us, &res[4]);
+	for (i = 0; i < PWRSEQ_TIMING_RES_STEPS; i++) {
+		/* Step index computed in int so it cannot wrap around */
+		if (host_req[2] + i > UINT8_MAX ||
+		    pwrseq_step_elapsed(seq, host_req[2] + i, &elapsed_us)) {
+			break;
+		}
+
+		sys_put_le32(elapsed_us, &res[PWRSEQ_TIMING_RES_HDR_SIZE +
+					      i * sizeof(uint32_t)]);
+	}
+
+	send_to_host(res, sizeof(res));
+}
+
+SMCHOST_CMD_DEFINE(SMCHOST_PLN_CONFIG, config_ssd_pln, 1, 0);
+SMCHOST_CMD_DEFINE(SMCHOST_GET_PWRSEQ_TIMING, get_pwrseq_timing, 2, 0);
+SMCHOST_CMD_DEFINE(SMCHOST_ENABLE_PWR_BTN_NOTIFY, enable_pwrbtn_notify, 0, 0);
+SMCHOST_CMD_DEFINE(SMCHOST_DISABLE_PWR_BTN_NOTIFY, disable_pwrbtn_notify,
+		   0, 0);
+SMCHOST_CMD_DEFINE(SMCHOST_ENABLE_PWR_BTN_SW, enable_pwrbtn_sw, 0, 0);
+SMCHOST_CMD_DEFINE(SMCHOST_DISABLE_PWR_BTN_SW, disable_pwrbtn_sw, 0, 0);
+SMCHOST_CMD_DEFINE(SMCHOST_GET_LEGACY_WAKE_STS, get_legacy_wake_sts, 0, 0);
+SMCHOST_CMD_DEFINE(SMCHOST_CLEAR_LEGACY_WAKE_STS, clear_legacy_wake_sts,
+		   0, 0);
+SMCHOST_CMD_DEFINE(SMCHOST_SX_ENTRY, sx_entry, 0, 0);
+SMCHOST_CMD_DEFINE(SMCHOST_SX_EXIT, sx_exit, 0, 0);
+SMCHOST_CMD_DEFINE(SMCHOST_SET_DSW_MODE, change_dsw_mode, 1, 0);
+SMCHOST_CMD_DEFINE(SMCHOST_GET_DSW_MODE, retrieve_dsw_mode, 0, 0);
+SMCHOST_CMD_DEFINE(SMCHOST_PG3_SET_MODE, change_pg3_mode, 1, 0);
+SMCHOST_CMD_DEFINE(SMCHOST_PG3_PROG_COUNTER, pg3_prog_counter, 0, 0);
+SMCHOST_CMD_DEFINE(SMCHOST_CS_LOW_PWR_MODE_SET, enable_cs_lpm_mode, 1, 0);
+SMCHOST_CMD_DEFINE(SMCHOST_CS_ENTRY, cs_entry, 0, 0);
+SMCHOST_CMD_DEFINE(SMCHOST_CS_EXIT, cs_exit, 0, 0);
+#ifdef CONFIG_DNX_EC_ASSISTED_TRIGGER_SMC
+SMCHOST_CMD_DEFINE(SMCHOST_DNX_TRIGGER, dnx_trigger, 0, 0);
+SMCHOST_CMD_DEFINE(SMCHOST_DNX_SET_STRAP, dnx_set_strap, 0, 0);
+#endif /* CONFIG_DNX_EC_ASSISTED_TRIGGER_SMC */
+#ifdef CONFIG_BOOT_PROFILER
+SMCHOST_CMD_DEFINE(SMCHOST_GET_BOOT_PROFILE, get_boot_profile, 1, 0);
+#endif
+#ifdef CONFIG_PWRSEQ_JOURNAL
+SMCHOST_CMD_DEFINE(SMCHOST_GET_PWRSEQ_JOURNAL, get_pwrseq_journal, 1, 0);
+#endif
+SMCHOST_CMD_DEFINE(SMCHOST_RESET_KSC, ec_reset, 0, 0);
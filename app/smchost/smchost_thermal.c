@@ -5,6 +5,7 @@
  */
 
 #include <logging/log.h>
+#include <sys/byteorder.h>
 #include "board.h"
 #include "board_config.h"
 #include "smc.h"
@@ -14,9 +15,13 @@
 #include "sci.h"
 #include "acpi.h"
 #include "thermalmgmt.h"
+#include "peci_hub.h"
 #ifdef CONFIG_DTT_SUPPORT_THERMALS
 #include "dtt.h"
 #endif
+#ifdef CONFIG_THERMAL_HISTORY
+#include "therm_hist.h"
+#endif
 
 LOG_MODULE_DECLARE(smchost, CONFIG_SMCHOST_LOG_LEVEL);
 
@@ -52,31 +57,56 @@ static void dtt_set_tmp_threshold(void)
 
 	smc_update_dtt_threshold_limits(sns, thrd);
 }
+
+/* DTT events returned per transaction */
+#define DTT_EVENTS_PER_READ	((SMCHOST_MAX_RES_SIZE - 3) / \
+				 sizeof(struct dtt_event))
+
+/**
+ * @brief Drains DTT sensor trip events, oldest first.
+ *
+ * Output
+ *  Byte 0: events still pending after this read
+ *  Byte 1: number of events returned
+ *  Byte 2: events dropped because queue was full
+ *  Byte 3 - 26: events, see struct dtt_event
+ */
+static void dtt_get_events(void)
+{
+	uint8_t res[3 + DTT_EVENTS_PER_READ * sizeof(struct dtt_event)];
+	uint8_t cnt;
+
+	cnt = dtt_pop_events((struct dtt_event *)&res[3],
+			     DTT_EVENTS_PER_READ, &res[2]);
+	res[0] = dtt_pending_events();
+	res[1] = cnt;
+
+	send_to_host(res, 3 + cnt * sizeof(struct dtt_event));
+}
 #endif /* CONFIG_DTT_SUPPORT_THERMALS */
 
 static void update_pwm(void)
 {
 #ifndef CONFIG_THERMAL_FAN_OVERRIDE
+	uint8_t fan_idx = g_acpi_tbl.acpi_fan_idx;
 
-	switch (g_acpi_tbl.acpi_fan_idx) {
-	case FAN_CPU:	/* For sake of backward compatibility, CPU fan allowed to run at index 0*/
-	case BIT(FAN_CPU):
-		host_update_fan_speed(FAN_CPU, g_acpi_tbl.acpi_pwm_end_val);
-		break;
-	case BIT(FAN_REAR):
-		host_update_fan_speed(FAN_REAR, g_acpi_tbl.acpi_pwm_end_val);
-		break;
-	case BIT(FAN_GFX):
-		host_update_fan_speed(FAN_GFX, g_acpi_tbl.acpi_pwm_end_val);
-		break;
-	case BIT(FAN_PCH):
-		host_update_fan_speed(FAN_PCH, g_acpi_tbl.acpi_pwm_end_val);
-		break;
-	default:
-		LOG_WRN("Invalid fan index, BIOS must send only one bit set per fan index");
-		break;
+	/* For sake of backward compatibility, CPU fan allowed to run at
+	 * index 0. Otherwise each bit set selects a fan to update.
+	 */
+	if (fan_idx == FAN_CPU) {
+		fan_idx = BIT(FAN_CPU);
 	}
 
+	if (fan_idx & ~BIT_MASK(FAN_DEV_TOTAL)) {
+		LOG_WRN("Invalid fan index %x", fan_idx);
+		return;
+	}
+
+	for (uint8_t idx = 0; idx < FAN_DEV_TOTAL; idx++) {
+		if (fan_idx & BIT(idx)) {
+			host_update_fan_speed(idx, g_acpi_tbl.acpi_pwm_end_val);
+		}
+	}
 #endif
 }
 
@@ -99,31 +129,101 @@ static void update_hw_peripherals_status(void)
 	send_to_host(hw_peripherals_sts, sizeof(hw_peripherals_sts));
 }
 
-void smchost_cmd_thermal_handler(uint8_t command)
+static void bios_fan_control(void)
 {
-	switch (command) {
-	case SMCHOST_SET_OS_ACTIVE_TRIP:
-		set_os_active_trip();
-		break;
-#ifdef CONFIG_DTT_SUPPORT_THERMALS
-	case SMCHOST_SET_TMP_THRESHOLD:
-		dtt_set_tmp_threshold();
-		break;
-#endif /* CONFIG_DTT_SUPPORT_THERMALS */
-	case SMCHOST_SET_SHDWN_THRESHOLD:
-		set_shutdown_threshold();
-		break;
-	case SMCHOST_UPDATE_PWM:
-		update_pwm();
-		break;
-	case SMCHOST_BIOS_FAN_CONTROL:
-		update_pwm_with_override(host_req[1]);
-		break;
-	case SMCHOST_GET_HW_PERIPHERALS_STS:
-		update_hw_peripherals_status();
-		break;
-	default:
-		LOG_WRN("%s: command 0x%X without handler", __func__, command);
-		break;
+	update_pwm_with_override(host_req[1]);
+}
+
+/**
+ * @brief Returns runtime information for a fan.
+ *
+ * Input
+ *  Byte 0: fan index
+ * Output
+ *  Byte 0 - 1: tach reading in rpm
+ *  Byte 2: duty cycle driven
+ *  Byte 3: duty cycle requested
+ *  Byte 4: fan zone temperature
+ */
+static void get_fan_info(void)
+{
+	struct thermal_fan_info info;
+	uint8_t res[5] = {0};
+
+	if (!thermalmgmt_get_fan_info(host_req[1], &info)) {
+		sys_put_le16(info.rpm, &res[0]);
+		res[2] = info.duty;
+		res[3] = info.target_duty;
+		res[4] = info.temp;
+	} else {
+		LOG_WRN("Invalid fan %d", host_req[1]);
+	}
+
+	send_to_host(res, sizeof(res));
+}
+
+#ifdef CONFIG_THERMAL_HISTORY
+/* Thermal history bytes returned per transaction */
+#define THERM_HIST_CHUNK_SIZE	(SMCHOST_MAX_RES_SIZE - 2)
+/* Read history snapshot saved in EEPROM instead of RAM history */
+#define THERM_HIST_SRC_EEPROM	BIT(7)
+
+/**
+ * @brief Returns part of a thermal history block, see struct
+ * therm_hist_block.
+ *
+ * Input
+ *  Byte 0: bit 7 selects EEPROM snapshot, bits 6-0 block index where 0 is
+ *          the most recent block
+ *  Byte 1: chunk index within block
+ * Output
+ *  Byte 0: number of blocks available
+ *  Byte 1: number of valid bytes in chunk, 0 past end of block
+ *  Byte 2 - 31: block data
+ */
+static void get_therm_history(void)
+{
+	bool eeprom = host_req[1] & THERM_HIST_SRC_EEPROM;
+	uint8_t blk = host_req[1] & ~THERM_HIST_SRC_EEPROM;
+	uint8_t res[SMCHOST_MAX_RES_SIZE] = {0};
+	int len;
+
+	res[0] = therm_hist_blocks(eeprom);
+	len = therm_hist_read(eeprom, blk, host_req[2] * THERM_HIST_CHUNK_SIZE,
+			      &res[2], THERM_HIST_CHUNK_SIZE);
+	if (len < 0) {
+		LOG_WRN("Invalid history block %d", blk);
+		len = 0;
 	}
+
+	res[1] = len;
+	send_to_host(res, sizeof(res));
+}
+#endif
+
+static void change_peci_access_mode(void)
+{
+#ifndef CONFIG_DEPRECATED_HW_STRAP_BASED_PECI_MODE_SEL
+	LOG_DBG("%s:Host peci_mode : %x", __func__, host_req[1]);
+	peci_access_mode_config(host_req[1]);
+#endif /* CONFIG_DEPRECATED_HW_STRAP_BASED_PECI_MODE_SEL */
 }
+
+SMCHOST_CMD_DEFINE(SMCHOST_SET_OS_ACTIVE_TRIP, set_os_active_trip, 0, 0);
+#ifdef CONFIG_DTT_SUPPORT_THERMALS
+SMCHOST_CMD_DEFINE(SMCHOST_SET_TMP_THRESHOLD, dtt_set_tmp_threshold,
+		   0, 0);
+SMCHOST_CMD_DEFINE(SMCHOST_DTT_GET_EVENTS, dtt_get_events, 0, 0);
+#endif /* CONFIG_DTT_SUPPORT_THERMALS */
+SMCHOST_CMD_DEFINE(SMCHOST_SET_SHDWN_THRESHOLD, set_shutdown_threshold,
+		   1, 0);
+SMCHOST_CMD_DEFINE(SMCHOST_UPDATE_PWM, update_pwm, 0, 0);
+SMCHOST_CMD_DEFINE(SMCHOST_GET_FAN_INFO, get_fan_info, 1, 0);
+#ifdef CONFIG_THERMAL_HISTORY
+SMCHOST_CMD_DEFINE(SMCHOST_GET_THERM_HISTORY, get_therm_history, 2, 0);
+#endif
+SMCHOST_CMD_DEFINE(SMCHOST_BIOS_FAN_CONTROL, bios_fan_control, 1, 0);
+SMCHOST_CMD_DEFINE(SMCHOST_GET_HW_PERIPHERALS_STS,
+		   update_hw_peripherals_status, 0, 0);
+SMCHOST_CMD_DEFINE(SMCHOST_SET_PECI_ACCESS_MODE, change_peci_access_mode,
+		   1, 0);
@@ -0,0 +1,67 @@
+/*
+ * Copyright (c) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr.h>
+#include "fan_pid.h"
+
+#define FAN_DUTY_MAX		100
+
+BUILD_ASSERT(CONFIG_THERMAL_FAN_PID_MIN_DUTY <= FAN_DUTY_MAX,
+	     "Invalid fan minimum duty cycle");
+
+void fan_pid_reset(struct fan_pid *pid)
+{
+	pid->integ = 0;
+	pid->prev_err = 0;
+	pid->duty = CONFIG_THERMAL_FAN_PID_MIN_DUTY;
+}
+
+uint8_t fan_pid_update(struct fan_pid *pid, int temp, int target,
+		       bool stalled, uint32_t dt_ms)
+{
+	int16_t err = temp - target;
+	int32_t integ;
+	int32_t out;
+
+	/* Integral and derivative gains are per reference period, scale
+	 * them so controller response does not depend on sampling period.
+	 */
+	dt_ms = MAX(dt_ms, 1);
+	integ = pid->integ + CONFIG_THERMAL_FAN_PID_KI * err * (int32_t)dt_ms /
+		CONFIG_THERMAL_FAN_PID_PERIOD_MS;
+
+	out = CONFIG_THERMAL_FAN_PID_KP * err + integ +
+	      CONFIG_THERMAL_FAN_PID_KD * (err - pid->prev_err) *
+	      CONFIG_THERMAL_FAN_PID_PERIOD_MS / (int32_t)dt_ms;
+	out /= FAN_PID_GAIN_SCALE;
+	pid->prev_err = err;
+
+	/* Conditional integration, only accept new integral term when it
+	 * does not drive output further into saturation.
+	 */
+	if (!stalled &&
+	    !(out > FAN_DUTY_MAX && err > 0) &&
+	    !(out < CONFIG_THERMAL_FAN_PID_MIN_DUTY && err < 0)) {
+		pid->integ = integ;
+	}
+
+	pid->duty = MIN(MAX(out, CONFIG_THERMAL_FAN_PID_MIN_DUTY), FAN_DUTY_MAX);
+
+	return pid->duty;
+}
+
+uint8_t fan_slew_limit(uint8_t cur, uint8_t target, uint8_t step)
+{
+	if (!step) {
+		return target;
+	}
+
+	if (target > cur) {
+		return MIN(target, cur + step);
+	}
+
+	return MAX(target, cur - step);
+}
@@ -0,0 +1,61 @@
+/*
+ * Copyright (c) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef __FAN_PID_H__
+#define __FAN_PID_H__
+
+/* Gains in Kconfig are scaled by this factor */
+#define FAN_PID_GAIN_SCALE	100
+
+/**
+ * @brief State of a fan temperature tracking controller.
+ */
+struct fan_pid {
+	/* Accumulated integral term, already multiplied by gain */
+	int32_t integ;
+	/* Error from previous iteration for derivative term */
+	int16_t prev_err;
+	/* Last duty cycle computed */
+	uint8_t duty;
+};
+
+/**
+ * @brief Reset controller state.
+ *
+ * @param pid controller instance.
+ */
+void fan_pid_reset(struct fan_pid *pid);
+
+/**
+ * @brief Compute fan duty cycle to track target temperature.
+ *
+ * Integral term is frozen while output is saturated or fan is stalled to
+ * avoid windup. Integral and derivative terms are scaled by time elapsed
+ * since previous update.
+ *
+ * @param pid controller instance.
+ * @param temp measured temperature in degree celsius.
+ * @param target target temperature in degree celsius.
+ * @param stalled true if tach reports fan is not spinning.
+ * @param dt_ms time since previous update in milliseconds.
+ *
+ * @retval duty cycle in percentage.
+ */
+uint8_t fan_pid_update(struct fan_pid *pid, int temp, int target,
+		       bool stalled, uint32_t dt_ms);
+
+/**
+ * @brief Limit duty cycle change per iteration.
+ *
+ * @param cur duty cycle currently applied.
+ * @param target duty cycle requested.
+ * @param step maximum change allowed, 0 means no limit.
+ *
+ * @retval duty cycle to apply.
+ */
+uint8_t fan_slew_limit(uint8_t cur, uint8_t target, uint8_t step);
+
+#endif /* __FAN_PID_H__ */
@@ -0,0 +1,193 @@
+/*
+ * Copyright (c) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr.h>
+#include <logging/log.h>
+#include "fan.h"
+#include "fan_tach.h"
+#include "smc.h"
+#include "sci.h"
+#include "scicodes.h"
+#include "pwrplane.h"
+
+LOG_MODULE_DECLARE(thermal, CONFIG_THERMAL_MGMT_LOG_LEVEL);
+
+#define TACH_FILTER_LEN		CONFIG_THERMAL_FAN_TACH_FILTER_LEN
+
+struct fan_tach {
+	/* Raw samples ring used by median filter */
+	uint16_t samples[TACH_FILTER_LEN];
+	uint8_t head;
+	uint8_t count;
+	uint16_t rpm;
+	/* Duty cycle driven and the one fan is ramping to */
+	uint8_t duty;
+	uint8_t target;
+	/* Stall check starts after this uptime, allows fan to spin-up */
+	uint32_t grace_end;
+	uint8_t stall_cnt;
+	bool stalled;
+};
+
+static struct fan_tach tach[FAN_DEV_TOTAL];
+static uint8_t max_fans;
+static bool tach_enabled;
+/* Fast sampling is kept until this uptime */
+static uint32_t fast_end;
+static struct k_work_delayable tach_work;
+
+static uint16_t tach_median(const struct fan_tach *t)
+{
+	uint16_t buf[TACH_FILTER_LEN];
+
+	for (uint8_t i = 0; i < t->count; i++) {
+		uint16_t val = t->samples[i];
+		int j = i - 1;
+
+		while (j >= 0 && buf[j] > val) {
+			buf[j + 1] = buf[j];
+			j--;
+		}
+
+		buf[j + 1] = val;
+	}
+
+	return buf[t->count / 2];
+}
+
+static void tach_check_stall(enum fan_type idx, struct fan_tach *t,
+			     uint32_t now)
+{
+	if ((int32_t)(now - t->grace_end) < 0) {
+		return;
+	}
+
+	if (t->duty < CONFIG_THERMAL_FAN_STALL_DUTY ||
+	    t->rpm >= CONFIG_THERMAL_FAN_STALL_RPM) {
+		if (t->stalled) {
+			LOG_INF("Fan %d recovered, rpm %d", idx, t->rpm);
+		}
+
+		t->stall_cnt = 0;
+		t->stalled = false;
+		return;
+	}
+
+	if (t->stalled || ++t->stall_cnt < CONFIG_THERMAL_FAN_STALL_SAMPLES) {
+		return;
+	}
+
+	t->stalled = true;
+	LOG_ERR("Fan %d stalled, duty %d rpm %d", idx, t->duty, t->rpm);
+	set_shutdown_reason(SHUTDOWN_REASON_FAN_FAILURE);
+	enqueue_sci(SCI_FAN_FAIL);
+}
+
+static void tach_work_handler(struct k_work *work)
+{
+	uint32_t now = k_uptime_get_32();
+	uint32_t period;
+
+	ARG_UNUSED(work);
+
+	for (uint8_t idx = 0; idx < max_fans; idx++) {
+		struct fan_tach *t = &tach[idx];
+		uint16_t rpm;
+
+		if (fan_read_rpm(idx, &rpm)) {
+			continue;
+		}
+
+		t->samples[t->head] = rpm;
+		t->head = (t->head + 1) % TACH_FILTER_LEN;
+		if (t->count < TACH_FILTER_LEN) {
+			t->count++;
+		}
+
+		t->rpm = tach_median(t);
+		smc_update_fan_tach(idx, t->rpm);
+		tach_check_stall(idx, t, now);
+	}
+
+	period = ((int32_t)(now - fast_end) < 0) ?
+		 CONFIG_THERMAL_FAN_TACH_FAST_PERIOD_MS :
+		 CONFIG_THERMAL_FAN_TACH_SLOW_PERIOD_MS;
+
+	if (tach_enabled) {
+		k_work_schedule(&tach_work, K_MSEC(period));
+	}
+}
+
+void fan_tach_init(uint8_t num_fans)
+{
+	max_fans = MIN(num_fans, FAN_DEV_TOTAL);
+	k_work_init_delayable(&tach_work, tach_work_handler);
+}
+
+void fan_tach_enable(bool enable)
+{
+	if (enable == tach_enabled) {
+		return;
+	}
+
+	tach_enabled = enable;
+	if (enable) {
+		k_work_schedule(&tach_work, K_NO_WAIT);
+		return;
+	}
+
+	k_work_cancel_delayable(&tach_work);
+	for (uint8_t idx = 0; idx < max_fans; idx++) {
+		tach[idx] = (struct fan_tach){ 0 };
+	}
+}
+
+void fan_tach_duty_changed(enum fan_type idx, uint8_t duty, uint8_t target)
+{
+	uint32_t now = k_uptime_get_32();
+	struct fan_tach *t;
+
+	if (idx >= max_fans) {
+		return;
+	}
+
+	t = &tach[idx];
+	t->duty = duty;
+
+	/* Intermediate ramp steps towards same target do not restart spin-up
+	 * handling, otherwise stall detection is held off for whole ramp.
+	 */
+	if (target == t->target) {
+		return;
+	}
+
+	/* Speed increase needs time before tach reflects it */
+	if (target > t->target) {
+		t->grace_end = now + CONFIG_THERMAL_FAN_SPINUP_GRACE_MS;
+		t->stall_cnt = 0;
+	}
+
+	t->target = target;
+	fast_end = now + CONFIG_THERMAL_FAN_SPINUP_GRACE_MS;
+
+	/* Bring slow sample forward, but never postpone a pending one */
+	if (tach_enabled &&
+	    k_work_delayable_remaining_get(&tach_work) >
+	    k_ms_to_ticks_ceil32(CONFIG_THERMAL_FAN_TACH_FAST_PERIOD_MS)) {
+		k_work_reschedule(&tach_work,
+				  K_MSEC(CONFIG_THERMAL_FAN_TACH_FAST_PERIOD_MS));
+	}
+}
+
+uint16_t fan_tach_rpm(enum fan_type idx)
+{
+	return (idx < max_fans) ? tach[idx].rpm : 0;
+}
+
+bool fan_tach_is_stalled(enum fan_type idx)
+{
+	return (idx < max_fans) ? tach[idx].stalled : false;
+}
@@ -0,0 +1,59 @@
+/*
+ * Copyright (c) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef __FAN_TACH_H__
+#define __FAN_TACH_H__
+
+#include "fan.h"
+
+/**
+ * @brief Initialize tach sampling for fan devices.
+ *
+ * @param num_fans number of fan devices in the board.
+ */
+void fan_tach_init(uint8_t num_fans);
+
+/**
+ * @brief Start or stop periodic tach sampling.
+ *
+ * Sampling is stopped while fan power is removed, filters and stall state
+ * are cleared.
+ *
+ * @param enable true to start sampling, false to stop.
+ */
+void fan_tach_enable(bool enable);
+
+/**
+ * @brief Notify tach sampling of a new duty cycle driven to a fan.
+ *
+ * When target duty cycle changes, sampling is sped up until fan settles
+ * and stall detection is held off during spin-up.
+ *
+ * @param idx fan device index.
+ * @param duty duty cycle in percentage.
+ * @param target duty cycle in percentage fan is ramping to.
+ */
+void fan_tach_duty_changed(enum fan_type idx, uint8_t duty, uint8_t target);
+
+/**
+ * @brief Get filtered fan speed.
+ *
+ * @param idx fan device index.
+ *
+ * @retval rotations per minute.
+ */
+uint16_t fan_tach_rpm(enum fan_type idx);
+
+/**
+ * @brief Check whether a fan is stalled.
+ *
+ * @param idx fan device index.
+ *
+ * @retval true if fan is driven but not spinning.
+ */
+bool fan_tach_is_stalled(enum fan_type idx);
+
+#endif /* __FAN_TACH_H__ */
@@ -0,0 +1,274 @@
+/*
+ * Copyright (c) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr.h>
+#include <errno.h>
+#include <sys/byteorder.h>
+#include <logging/log.h>
+#include "eeprom.h"
+#include "memops.h"
+#include "therm_hist.h"
+
+LOG_MODULE_DECLARE(thermal, CONFIG_THERMAL_MGMT_LOG_LEVEL);
+
+#define HIST_SAMPLES_PER_BLK	(THERM_HIST_DELTAS + 1)
+#define HIST_SAMPLES		(CONFIG_THERMAL_HISTORY_DEPTH_SEC * MSEC_PER_SEC / \
+				 CONFIG_THERMAL_HISTORY_PERIOD_MS)
+/* One extra block as the one being filled is partial */
+#define HIST_BLOCKS		(ceiling_fraction(HIST_SAMPLES, \
+						  HIST_SAMPLES_PER_BLK) + 1)
+
+/* Delta encoding units */
+#define HIST_TEMP_UNIT		1
+#define HIST_DUTY_UNIT		2
+#define HIST_RPM_UNIT		64
+#define HIST_DELTA_MIN		-8
+#define HIST_DELTA_MAX		7
+
+/* EEPROM snapshot layout: header followed by most recent blocks */
+#define HIST_EEPROM_MAGIC0	'T'
+#define HIST_EEPROM_MAGIC1	'H'
+#define HIST_EEPROM_VERSION	1U
+#define HIST_EEPROM_HDR_SIZE	4U
+#define HIST_EEPROM_BLOCKS	MIN(CONFIG_THERMAL_HISTORY_EEPROM_BLOCKS, \
+				    HIST_BLOCKS)
+#define HIST_EEPROM_PAGE_SIZE	16U
+
+BUILD_ASSERT(FAN_TEMP_SRC_TOTAL % 2 == 0 && FAN_DEV_TOTAL % 2 == 0,
+	     "History deltas are packed in pairs");
+BUILD_ASSERT(HIST_BLOCKS <= UINT8_MAX, "History depth too large");
+BUILD_ASSERT(CONFIG_THERMAL_HISTORY_EEPROM_OFFSET % HIST_EEPROM_PAGE_SIZE == 0,
+	     "History snapshot must be page aligned");
+BUILD_ASSERT(CONFIG_THERMAL_HISTORY_EEPROM_OFFSET + HIST_EEPROM_HDR_SIZE +
+	     HIST_EEPROM_BLOCKS * sizeof(struct therm_hist_block) <=
+	     EEPROM_SIZE, "History snapshot does not fit EEPROM");
+
+/* History is recorded by thermal thread and read by smchost thread */
+K_MUTEX_DEFINE(hist_lock);
+
+static struct therm_hist_block hist[HIST_BLOCKS];
+/* Block currently being filled */
+static uint8_t hist_head;
+static uint8_t hist_used;
+static uint32_t last_sample;
+static bool hist_started;
+/* Values reconstructed from deltas so far in current block */
+static struct therm_hist_sample recon;
+
+static int8_t hist_delta(int32_t val, int32_t *prev, int32_t unit)
+{
+	int32_t delta = (val - *prev) / unit;
+
+	delta = MIN(MAX(delta, HIST_DELTA_MIN), HIST_DELTA_MAX);
+	*prev += delta * unit;
+
+	return delta;
+}
+
+static void hist_pack(uint8_t *buf, uint8_t idx, int8_t delta)
+{
+	buf[idx / 2] |= (delta & 0xF) << ((idx & 1) * 4);
+}
+
+static void hist_new_block(const struct therm_hist_sample *sample,
+			   uint32_t now)
+{
+	struct therm_hist_key *key;
+
+	if (hist_started) {
+		hist_head = (hist_head + 1) % HIST_BLOCKS;
+	}
+
+	hist_started = true;
+	hist_used = MIN(hist_used + 1, HIST_BLOCKS);
+
+	memsets(&hist[hist_head], 0, sizeof(hist[hist_head]));
+	key = &hist[hist_head].key;
+	key->uptime_sec = sys_cpu_to_le32(now / MSEC_PER_SEC);
+	for (uint8_t i = 0; i < FAN_TEMP_SRC_TOTAL; i++) {
+		key->temp[i] = sample->temp[i];
+	}
+
+	for (uint8_t i = 0; i < FAN_DEV_TOTAL; i++) {
+		key->duty[i] = sample->duty[i];
+		key->rpm[i] = sys_cpu_to_le16(sample->rpm[i]);
+	}
+
+	key->pwr_state = sample->pwr_state;
+	recon = *sample;
+}
+
+static void hist_add_delta(const struct therm_hist_sample *sample)
+{
+	struct therm_hist_block *blk = &hist[hist_head];
+	struct therm_hist_delta *delta = &blk->delta[blk->key.count++];
+	int32_t prev;
+
+	for (uint8_t i = 0; i < FAN_TEMP_SRC_TOTAL; i++) {
+		prev = recon.temp[i];
+		hist_pack(delta->temp, i,
+			  hist_delta(sample->temp[i], &prev, HIST_TEMP_UNIT));
+		recon.temp[i] = prev;
+	}
+
+	for (uint8_t i = 0; i < FAN_DEV_TOTAL; i++) {
+		prev = recon.duty[i];
+		hist_pack(delta->duty, i,
+			  hist_delta(sample->duty[i], &prev, HIST_DUTY_UNIT));
+		recon.duty[i] = prev;
+
+		prev = recon.rpm[i];
+		hist_pack(delta->rpm, i,
+			  hist_delta(sample->rpm[i], &prev, HIST_RPM_UNIT));
+		recon.rpm[i] = prev;
+	}
+}
+
+void therm_hist_record(const struct therm_hist_sample *sample)
+{
+	uint32_t now = k_uptime_get_32();
+	uint32_t elapsed = now - last_sample;
+
+	if (hist_started && elapsed < CONFIG_THERMAL_HISTORY_PERIOD_MS) {
+		return;
+	}
+
+	last_sample = now;
+
+	k_mutex_lock(&hist_lock, K_FOREVER);
+
+	/* Deltas are implicitly one period apart, start a new block when
+	 * sampling was delayed, power state changed or block is full.
+	 */
+	if (!hist_started ||
+	    elapsed > CONFIG_THERMAL_HISTORY_PERIOD_MS * 3 / 2 ||
+	    sample->pwr_state != hist[hist_head].key.pwr_state ||
+	    hist[hist_head].key.count == THERM_HIST_DELTAS) {
+		hist_new_block(sample, now);
+	} else {
+		hist_add_delta(sample);
+	}
+
+	k_mutex_unlock(&hist_lock);
+}
+
+static int hist_eeprom_write(uint16_t offset, uint8_t *buf, uint16_t len)
+{
+	int ret;
+
+	while (len) {
+		/* Page writes wrap around within a page */
+		uint8_t chunk = MIN(len, HIST_EEPROM_PAGE_SIZE -
+				    (offset % HIST_EEPROM_PAGE_SIZE));
+
+		ret = eeprom_write_block(offset, chunk, buf);
+		if (ret) {
+			return ret;
+		}
+
+		offset += chunk;
+		buf += chunk;
+		len -= chunk;
+	}
+
+	return 0;
+}
+
+void therm_hist_save(void)
+{
+	uint16_t offset = CONFIG_THERMAL_HISTORY_EEPROM_OFFSET;
+	uint8_t count;
+	/* Invalidate old snapshot first in case save is interrupted */
+	uint8_t hdr[HIST_EEPROM_HDR_SIZE] = {
+		HIST_EEPROM_MAGIC0, HIST_EEPROM_MAGIC1,
+		HIST_EEPROM_VERSION, 0,
+	};
+	int ret;
+
+	k_mutex_lock(&hist_lock, K_FOREVER);
+	count = MIN(hist_used, HIST_EEPROM_BLOCKS);
+	ret = hist_eeprom_write(offset, hdr, sizeof(hdr));
+
+	for (uint8_t blk = 0; blk < count && !ret; blk++) {
+		uint8_t idx = (hist_head + HIST_BLOCKS - blk) % HIST_BLOCKS;
+
+		ret = hist_eeprom_write(offset + HIST_EEPROM_HDR_SIZE +
+					blk * sizeof(struct therm_hist_block),
+					(uint8_t *)&hist[idx],
+					sizeof(struct therm_hist_block));
+	}
+
+	if (!ret) {
+		hdr[3] = count;
+		ret = hist_eeprom_write(offset, hdr, sizeof(hdr));
+	}
+
+	k_mutex_unlock(&hist_lock);
+
+	if (ret) {
+		LOG_ERR("Failed to save thermal history %d", ret);
+		return;
+	}
+
+	LOG_INF("Saved %d thermal history blocks", count);
+}
+
+uint8_t therm_hist_blocks(bool eeprom)
+{
+	uint8_t hdr[HIST_EEPROM_HDR_SIZE];
+
+	if (!eeprom) {
+		return hist_used;
+	}
+
+	if (eeprom_read_block(CONFIG_THERMAL_HISTORY_EEPROM_OFFSET,
+			      sizeof(hdr), hdr) ||
+	    hdr[0] != HIST_EEPROM_MAGIC0 || hdr[1] != HIST_EEPROM_MAGIC1 ||
+	    hdr[2] != HIST_EEPROM_VERSION) {
+		return 0;
+	}
+
+	return MIN(hdr[3], HIST_EEPROM_BLOCKS);
+}
+
+int therm_hist_read(bool eeprom, uint8_t blk, uint16_t offset, uint8_t *buf,
+		    uint8_t len)
+{
+	uint8_t idx;
+	int ret;
+
+	if (offset >= sizeof(struct therm_hist_block)) {
+		return 0;
+	}
+
+	len = MIN(len, sizeof(struct therm_hist_block) - offset);
+
+	if (eeprom) {
+		if (blk >= therm_hist_blocks(true)) {
+			return -EINVAL;
+		}
+
+		ret = eeprom_read_block(CONFIG_THERMAL_HISTORY_EEPROM_OFFSET +
+					HIST_EEPROM_HDR_SIZE +
+					blk * sizeof(struct therm_hist_block) +
+					offset, len, buf);
+
+		return ret ? ret : len;
+	}
+
+	k_mutex_lock(&hist_lock, K_FOREVER);
+
+	if (blk >= hist_used) {
+		k_mutex_unlock(&hist_lock);
+		return -EINVAL;
+	}
+
+	idx = (hist_head + HIST_BLOCKS - blk) % HIST_BLOCKS;
+	memcpys(buf, (uint8_t *)&hist[idx] + offset, len);
+	k_mutex_unlock(&hist_lock);
+
+	return len;
+}
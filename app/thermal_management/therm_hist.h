@@ -0,0 +1,98 @@
+/*
+ * Copyright (c) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef __THERM_HIST_H__
+#define __THERM_HIST_H__
+
+#include "fan.h"
+
+/* Delta records following each key record in a history block */
+#define THERM_HIST_DELTAS		15U
+
+/**
+ * @brief Thermal and fan state recorded in history.
+ */
+struct therm_hist_sample {
+	/* Temperature per source in degree celsius */
+	int8_t temp[FAN_TEMP_SRC_TOTAL];
+	uint8_t duty[FAN_DEV_TOTAL];
+	uint16_t rpm[FAN_DEV_TOTAL];
+	uint8_t pwr_state;
+};
+
+/**
+ * @brief Absolute sample starting a history block.
+ *
+ * Multi-byte fields are little endian.
+ */
+struct therm_hist_key {
+	uint32_t uptime_sec;
+	int8_t temp[FAN_TEMP_SRC_TOTAL];
+	uint8_t duty[FAN_DEV_TOTAL];
+	uint16_t rpm[FAN_DEV_TOTAL];
+	uint8_t pwr_state;
+	/* Number of valid delta records in block */
+	uint8_t count;
+} __packed;
+
+/**
+ * @brief Sample encoded as signed 4-bit deltas from previous sample.
+ *
+ * Temperature in 1 C, duty cycle in 2 % and speed in 64 rpm units.
+ * Larger changes saturate and are caught up by following records.
+ */
+struct therm_hist_delta {
+	uint8_t temp[FAN_TEMP_SRC_TOTAL / 2];
+	uint8_t duty[FAN_DEV_TOTAL / 2];
+	uint8_t rpm[FAN_DEV_TOTAL / 2];
+} __packed;
+
+/**
+ * @brief Run of samples taken at history period in the same power state.
+ */
+struct therm_hist_block {
+	struct therm_hist_key key;
+	struct therm_hist_delta delta[THERM_HIST_DELTAS];
+} __packed;
+
+/**
+ * @brief Record a sample if history period elapsed since last one.
+ *
+ * @param sample current thermal and fan state.
+ */
+void therm_hist_record(const struct therm_hist_sample *sample);
+
+/**
+ * @brief Number of history blocks available.
+ *
+ * @param eeprom true for snapshot saved in EEPROM, false for RAM history.
+ *
+ * @retval number of blocks.
+ */
+uint8_t therm_hist_blocks(bool eeprom);
+
+/**
+ * @brief Read part of a history block.
+ *
+ * @param eeprom true for snapshot saved in EEPROM, false for RAM history.
+ * @param blk block index, 0 is the most recent.
+ * @param offset byte offset within block.
+ * @param buf buffer to copy data to.
+ * @param len maximum number of bytes to copy.
+ *
+ * @retval number of bytes copied, negative errno on failure.
+ */
+int therm_hist_read(bool eeprom, uint8_t blk, uint16_t offset, uint8_t *buf,
+		    uint8_t len);
+
+/**
+ * @brief Save most recent history blocks to EEPROM.
+ *
+ * Blocking call, intended for thermal shutdown once power rails are off.
+ */
+void therm_hist_save(void);
+
+#endif /* __THERM_HIST_H__ */
@@ -0,0 +1,158 @@
+/*
+ * Copyright (c) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr.h>
+#include <logging/log.h>
+#include "softstrap.h"
+#include "therm_sched.h"
+
+LOG_MODULE_DECLARE(thermal, CONFIG_THERMAL_MGMT_LOG_LEVEL);
+
+/* Bounds accepted from softstrap */
+#define THERM_SCHED_MIN_PERIOD_MS	20U
+#define THERM_SCHED_MAX_PERIOD_MS	8000U
+
+/* Readings are in whole degrees, slope is only computed against a reference
+ * sample at least this old so a single step does not look like a fast rise
+ * when sampling period is short.
+ */
+#define THERM_SCHED_SLOPE_WINDOW_MS	1000U
+/* Slope filter time constant */
+#define THERM_SCHED_SLOPE_TAU_MS	1000U
+
+struct therm_src_state {
+	/* Reference sample for slope computation */
+	int16_t temp;
+	/* Smoothed slope in 0.1 degree celsius per second */
+	int16_t slope;
+	uint32_t timestamp;
+	bool valid;
+};
+
+static struct therm_src_state src_state[FAN_TEMP_SRC_TOTAL];
+
+static uint32_t min_period;
+static uint32_t max_period;
+static uint32_t base_period;
+static uint32_t cur_period;
+static int16_t slope_thrsd;
+static uint8_t crit_margin;
+/* Set when a source requires fast sampling in current iteration */
+static bool urgent;
+/* Set when a source is rising but not fast enough to be urgent */
+static bool warming;
+
+void therm_sched_init(uint32_t normal_period)
+{
+	const struct softstrap_region *strps = sw_strps();
+	const struct dtt_config *cfg = &strps->dtt_cfg;
+
+	min_period = CONFIG_THERMAL_ADAPTIVE_MIN_PERIOD_MS;
+	max_period = CONFIG_THERMAL_ADAPTIVE_MAX_PERIOD_MS;
+	slope_thrsd = CONFIG_THERMAL_ADAPTIVE_SLOPE;
+	crit_margin = CONFIG_THERMAL_ADAPTIVE_CRIT_MARGIN;
+
+	if (cfg->therm_min_period) {
+		min_period = THERM_PERIOD_TO_MS(cfg->therm_min_period);
+	}
+
+	if (cfg->therm_max_period) {
+		max_period = THERM_MAX_PERIOD_TO_MS(cfg->therm_max_period);
+	}
+
+	if (cfg->therm_slope) {
+		slope_thrsd = cfg->therm_slope;
+	}
+
+	if (cfg->therm_crit_margin) {
+		crit_margin = cfg->therm_crit_margin;
+	}
+
+	base_period = normal_period;
+	min_period = MIN(MAX(min_period, THERM_SCHED_MIN_PERIOD_MS),
+			 base_period);
+	max_period = MIN(MAX(max_period, base_period),
+			 THERM_SCHED_MAX_PERIOD_MS);
+	cur_period = base_period;
+
+	LOG_INF("Thermal sampling %d-%d ms, slope %d.%d C/s", min_period,
+		max_period, slope_thrsd / 10, slope_thrsd % 10);
+}
+
+void therm_sched_reset(void)
+{
+	for (uint8_t idx = 0; idx < FAN_TEMP_SRC_TOTAL; idx++) {
+		src_state[idx].valid = false;
+	}
+
+	cur_period = base_period;
+}
+
+void therm_sched_update(enum fan_temp_src src, int temp, int crit)
+{
+	struct therm_src_state *state;
+	uint32_t now = k_uptime_get_32();
+	uint32_t delta_ms;
+	int32_t slope;
+	int32_t num;
+	int32_t den;
+
+	if (src >= FAN_TEMP_SRC_TOTAL) {
+		return;
+	}
+
+	state = &src_state[src];
+	if (temp >= crit - crit_margin) {
+		urgent = true;
+	}
+
+	if (!state->valid) {
+		state->temp = temp;
+		state->timestamp = now;
+		state->slope = 0;
+		state->valid = true;
+		return;
+	}
+
+	delta_ms = now - state->timestamp;
+	if (delta_ms >= THERM_SCHED_SLOPE_WINDOW_MS) {
+		slope = (temp - state->temp) * 10 * MSEC_PER_SEC /
+			(int32_t)delta_ms;
+		/* Filter weight depends on elapsed time, not sample count,
+		 * rounded so slope settles on a constant trend.
+		 */
+		num = (slope - state->slope) * (int32_t)delta_ms;
+		den = delta_ms + THERM_SCHED_SLOPE_TAU_MS;
+		state->slope += (num + (num < 0 ? -den / 2 : den / 2)) / den;
+		state->temp = temp;
+		state->timestamp = now;
+	}
+
+	if (state->slope >= slope_thrsd) {
+		urgent = true;
+	} else if (state->slope > slope_thrsd / 4) {
+		warming = true;
+	}
+}
+
+uint32_t therm_sched_next_period(void)
+{
+	if (urgent) {
+		cur_period = min_period;
+	} else if (warming) {
+		cur_period = base_period;
+	} else if (cur_period < base_period) {
+		cur_period = base_period;
+	} else {
+		/* Stable, back off gradually */
+		cur_period = MIN(cur_period + cur_period / 2, max_period);
+	}
+
+	urgent = false;
+	warming = false;
+
+	return cur_period;
+}
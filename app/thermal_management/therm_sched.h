@@ -0,0 +1,47 @@
+/*
+ * Copyright (c) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef __THERM_SCHED_H__
+#define __THERM_SCHED_H__
+
+#include "fan.h"
+
+/**
+ * @brief Initialize adaptive thermal sampling.
+ *
+ * Period limits are taken from softstrap DTT block when supported,
+ * otherwise from Kconfig defaults.
+ *
+ * @param normal_period thermal thread period in milliseconds.
+ */
+void therm_sched_init(uint32_t normal_period);
+
+/**
+ * @brief Reset temperature history, e.g. when sources stop being read.
+ */
+void therm_sched_reset(void);
+
+/**
+ * @brief Record new temperature reading for a source.
+ *
+ * @param src temperature source.
+ * @param temp temperature in degree celsius.
+ * @param crit critical temperature in degree celsius.
+ */
+void therm_sched_update(enum fan_temp_src src, int temp, int crit);
+
+/**
+ * @brief Compute thermal thread period for next iteration.
+ *
+ * Period drops to minimum when any source rises fast or gets close to
+ * critical temperature, and backs off towards maximum while all sources
+ * are stable.
+ *
+ * @retval period in milliseconds.
+ */
+uint32_t therm_sched_next_period(void);
+
+#endif /* __THERM_SCHED_H__ */
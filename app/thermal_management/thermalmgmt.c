@@ -4,6 +4,7 @@
  * SPDX-License-Identifier: Apache-2.0
  */
 
+#include <errno.h>
 #include <zephyr.h>
 #include <logging/log.h>
 #include "thermalmgmt.h"
@@ -20,9 +21,19 @@
 #include "memops.h"
 #include "gpio_ec.h"
 #include "task_handler.h"
+#include "fan_tach.h"
+#ifdef CONFIG_THERMAL_FAN_PID
+#include "fan_pid.h"
+#endif
 #ifdef CONFIG_DTT_SUPPORT_THERMALS
 #include "dtt.h"
 #endif
+#ifdef CONFIG_THERMAL_ADAPTIVE_SAMPLING
+#include "therm_sched.h"
+#endif
+#ifdef CONFIG_THERMAL_HISTORY
+#include "therm_hist.h"
+#endif
 
 LOG_MODULE_REGISTER(thermal, CONFIG_THERMAL_MGMT_LOG_LEVEL);
 
@@ -62,6 +73,25 @@ LOG_MODULE_REGISTER(thermal, CONFIG_THERMAL_MGMT_LOG_LEVEL);
  */
 #define GET_FAN_SPEED_FOR_TEMP(temp)		(temp & (~0x7))
 
+#define FAN_KICK_START_DUTY			100U
+#define FAN_MAX_DUTY				100U
+
+#ifdef CONFIG_THERMAL_FAN_PID
+/* Longest elapsed time accounted in one fan control iteration */
+#define FAN_CTRL_MAX_PERIODS			4U
+#endif
+
+#ifdef CONFIG_THERMAL_PREDICTIVE_SHUTDOWN
+/* CPU temperature trend is tracked in 1/16 degree celsius */
+#define TREND_FRAC_BITS				4
+/* Filter time constant, weight of a sample depends on time it covers */
+#define TREND_FILTER_TAU_MS			750U
+/* Slope is computed against a reference at least this old, so a single
+ * degree step does not look like a fast rise at short sampling periods.
+ */
+#define TREND_SLOPE_WINDOW_MS			1000U
+#endif
+
 static uint8_t therm_sensors[ACPI_THRM_SEN_TOTAL] = {
 	[0 ... ACPI_THRM_SEN_TOTAL-1] = ADC_CH_UNDEF};
 struct fan_dev *fan_dev_tbl;
@@ -74,7 +104,33 @@ static bool bios_fan_override;
 static uint8_t bios_fan_speed;
 static uint8_t fan_duty_cycle[FAN_DEV_TOTAL];
 static bool fan_duty_cycle_change;
+/* Duty cycle currently driven, may lag fan_duty_cycle while ramping */
+static uint8_t fan_duty_applied[FAN_DEV_TOTAL];
+#ifdef CONFIG_THERMAL_FAN_PID
+static struct fan_pid fan_pid[FAN_DEV_TOTAL];
+/* Slew step credit carried between iterations, duty x reference period */
+static uint32_t fan_ramp_credit[FAN_DEV_TOTAL];
+/* Time of previous fan control iteration, 0 after reset */
+static uint32_t fan_ctrl_time;
+#endif
 static int cpu_temp;
+#ifdef CONFIG_THERMAL_PREDICTIVE_SHUTDOWN
+struct therm_trend {
+	/* Filtered temperature and slope per second, fixed point */
+	int32_t temp;
+	int32_t slope;
+	uint32_t timestamp;
+	/* Filtered temperature used as slope reference */
+	int32_t ref_temp;
+	uint32_t ref_time;
+	bool valid;
+};
+
+static struct therm_trend cpu_trend;
+/* Set while EC throttles to avoid predicted critical temperature */
+static bool therm_escalated;
+static uint32_t escalate_end;
+#endif
 
 void host_update_crit_temp(uint8_t crit_temp)
 {
@@ -153,6 +209,8 @@ static void init_fans(void)
 		LOG_ERR("Failed to init fan");
 	}
 
+	fan_tach_init(max_fan_dev);
+
 	fan_duty_cycle[FAN_CPU] = CONFIG_THERMAL_FAN_OVERRIDE_VALUE;
 	fan_duty_cycle_change = 1;
 }
@@ -222,26 +280,235 @@ void host_update_fan_speed(enum fan_type idx, uint8_t duty_cycle)
 	}
 }
 
+uint8_t thermalmgmt_get_fan_duty(enum fan_type idx)
+{
+	if (idx >= max_fan_dev) {
+		return 0;
+	}
+
+	return fan_duty_applied[idx];
+}
+
+static inline bool therm_escalated_active(void)
+{
+#ifdef CONFIG_THERMAL_PREDICTIVE_SHUTDOWN
+	return therm_escalated;
+#else
+	return false;
+#endif
+}
+
+static void fan_apply_duty(enum fan_type idx, uint8_t duty)
+{
+	fan_set_duty_cycle(idx, duty);
+	fan_duty_applied[idx] = duty;
+	fan_tach_duty_changed(idx, duty, fan_duty_cycle[idx]);
+}
+
+#ifdef CONFIG_THERMAL_FAN_PID
+static uint8_t fan_slew_step(void)
+{
+	/* BIOS provided step takes precedence over build default */
+	if (g_acpi_tbl.acpi_pwm_step) {
+		return g_acpi_tbl.acpi_pwm_step;
+	}
+
+	return CONFIG_THERMAL_FAN_PID_SLEW_STEP;
+}
+
+/* Time since previous fan control iteration, limited so integral term and
+ * ramp do not jump after thermal thread was not running.
+ */
+static uint32_t fan_ctrl_elapsed(void)
+{
+	uint32_t now = k_uptime_get_32();
+	uint32_t dt_ms = CONFIG_THERMAL_FAN_PID_PERIOD_MS;
+
+	if (fan_ctrl_time) {
+		dt_ms = MIN(now - fan_ctrl_time,
+			    FAN_CTRL_MAX_PERIODS * CONFIG_THERMAL_FAN_PID_PERIOD_MS);
+	}
+
+	fan_ctrl_time = now;
+
+	return dt_ms;
+}
+
+static uint8_t fan_ramp_limit(enum fan_type idx, uint8_t step, uint32_t dt_ms)
+{
+	uint32_t max_change;
+
+	if (fan_duty_applied[idx] == fan_duty_cycle[idx]) {
+		fan_ramp_credit[idx] = 0;
+		return fan_duty_applied[idx];
+	}
+
+	/* Step is per reference period, remainder is carried over so
+	 * shorter thermal periods ramp at the same rate.
+	 */
+	fan_ramp_credit[idx] += step * dt_ms;
+	max_change = fan_ramp_credit[idx] / CONFIG_THERMAL_FAN_PID_PERIOD_MS;
+	if (!max_change) {
+		return fan_duty_applied[idx];
+	}
+
+	fan_ramp_credit[idx] -= max_change * CONFIG_THERMAL_FAN_PID_PERIOD_MS;
+
+	return fan_slew_limit(fan_duty_applied[idx], fan_duty_cycle[idx],
+			      MIN(max_change, FAN_MAX_DUTY));
+}
+
+static void fan_ramp_duty(uint32_t dt_ms)
+{
+	uint8_t step = fan_slew_step();
+	uint8_t duty;
+
+	for (uint8_t idx = 0; idx < max_fan_dev; idx++) {
+		/* Overrides are safety measures and not rate limited,
+		 * stalled fan gets a full duty kick to overcome friction.
+		 */
+		if (fan_override || therm_escalated_active() ||
+		    (idx == FAN_CPU &&
+		     therm_bsod_override_acpi.is_bsod_temp_crossed)) {
+			duty = fan_duty_cycle[idx];
+		} else if (fan_tach_is_stalled(idx)) {
+			duty = FAN_KICK_START_DUTY;
+			LOG_WRN("Fan %d stalled, kick start", idx);
+		} else if (!step) {
+			duty = fan_duty_cycle[idx];
+		} else {
+			duty = fan_ramp_limit(idx, step, dt_ms);
+		}
+
+		if (duty != fan_duty_applied[idx]) {
+			fan_apply_duty(idx, duty);
+		}
+	}
+}
+
+static void fan_reset_control(void)
+{
+	for (uint8_t idx = 0; idx < max_fan_dev; idx++) {
+		fan_pid_reset(&fan_pid[idx]);
+		fan_duty_applied[idx] = 0;
+		fan_ramp_credit[idx] = 0;
+	}
+
+	fan_ctrl_time = 0;
+}
+#endif
+
+static int therm_src_temp(enum fan_temp_src src)
+{
+	uint8_t sen;
+
+	switch (src) {
+	case FAN_TEMP_SRC_GPU:
+		return g_acpi_tbl.acpi_gpu_temp;
+	case FAN_TEMP_SRC_PCH:
+		return g_acpi_tbl.acpi_pch_dts_temp;
+	case FAN_TEMP_SRC_SEN1:
+	case FAN_TEMP_SRC_SEN2:
+	case FAN_TEMP_SRC_SEN3:
+	case FAN_TEMP_SRC_SEN4:
+	case FAN_TEMP_SRC_SEN5:
+		sen = therm_sensors[src - FAN_TEMP_SRC_SEN1];
+		if (sen < ADC_CH_TOTAL) {
+			/* Thermistor readings are in 0.1 degree celsius */
+			return adc_temp_val[sen] / 10;
+		}
+
+		/* Sensor not present in this board, fall back to CPU */
+		return cpu_temp;
+	case FAN_TEMP_SRC_CPU:
+	default:
+		return cpu_temp;
+	}
+}
+
+static int fan_zone_temp(const struct fan_zone *zone)
+{
+	return therm_src_temp(zone->temp_src);
+}
+
+static uint8_t fan_zone_duty(enum fan_type idx, uint32_t dt_ms)
+{
+	const struct fan_zone *zone = &fan_dev_tbl[idx].zone;
+	int temp = fan_zone_temp(zone);
+
+#ifdef CONFIG_THERMAL_FAN_PID
+	int target = zone->target_temp ? zone->target_temp :
+		     CONFIG_THERMAL_FAN_PID_TARGET_TEMP;
+
+	return fan_pid_update(&fan_pid[idx], temp, target,
+			      fan_tach_is_stalled(idx), dt_ms);
+#else
+	ARG_UNUSED(dt_ms);
+
+	if (!zone->temp_max) {
+		return GET_FAN_SPEED_FOR_TEMP(temp);
+	}
+
+	if (temp <= zone->temp_min) {
+		return zone->duty_min;
+	}
+
+	if (temp >= zone->temp_max) {
+		return FAN_MAX_DUTY;
+	}
+
+	return zone->duty_min + ((temp - zone->temp_min) *
+		(FAN_MAX_DUTY - zone->duty_min)) /
+		(zone->temp_max - zone->temp_min);
+#endif
+}
+
+int thermalmgmt_get_fan_info(enum fan_type idx, struct thermal_fan_info *info)
+{
+	if (idx >= max_fan_dev || fan_dev_tbl[idx].pwm_ch == PWM_CH_UNDEF) {
+		return -EINVAL;
+	}
+
+	info->rpm = fan_tach_rpm(idx);
+	info->duty = fan_duty_applied[idx];
+	info->target_duty = fan_duty_cycle[idx];
+	info->temp = fan_zone_temp(&fan_dev_tbl[idx].zone);
+
+	return 0;
+}
+
 static void manage_fan(void)
 {
+	uint32_t dt_ms = 0;
+
 	/* Disable power to fan in S5/4/3 and in CS,
 	 * else continue with fan management.
 	 */
 	if ((pwrseq_system_state() != SYSTEM_S0_STATE) ||
 		(smchost_is_system_in_cs())) {
 		fan_power_set(false);
+		fan_tach_enable(false);
+#ifdef CONFIG_THERMAL_FAN_PID
+		fan_reset_control();
+#endif
 		return;
 	}
 	/* Enable power to fan when system is in S0 and not in CS */
 	fan_power_set(true);
+	fan_tach_enable(true);
+#ifdef CONFIG_THERMAL_FAN_PID
+	dt_ms = fan_ctrl_elapsed();
+#endif
 
 	if (!is_fan_controlled_by_host()) {
-		/* EC Self control fan based on CPU thermal info */
-		uint8_t cpu_fan_speed = GET_FAN_SPEED_FOR_TEMP(cpu_temp);
+		/* EC Self control each fan based on its zone thermal info */
+		for (uint8_t idx = 0; idx < max_fan_dev; idx++) {
+			uint8_t fan_speed = fan_zone_duty(idx, dt_ms);
 
-		if (fan_duty_cycle[FAN_CPU] != cpu_fan_speed) {
-			fan_duty_cycle[FAN_CPU] = cpu_fan_speed;
-			fan_duty_cycle_change = 1;
+			if (fan_duty_cycle[idx] != fan_speed) {
+				fan_duty_cycle[idx] = fan_speed;
+				fan_duty_cycle_change = 1;
+			}
 		}
 	}
 
@@ -249,23 +516,10 @@ static void manage_fan(void)
 	 * This is mostly used for PO entry on PO team request
 	 */
 	if (fan_override) {
-		fan_duty_cycle[FAN_CPU] = CONFIG_THERMAL_FAN_OVERRIDE_VALUE;
-		fan_duty_cycle_change = 1;
-	}
-
-	if (fan_duty_cycle_change) {
-		fan_duty_cycle_change = 0;
-
 		for (uint8_t idx = 0; idx < max_fan_dev; idx++) {
-			fan_set_duty_cycle(idx, fan_duty_cycle[idx]);
+			fan_duty_cycle[idx] = CONFIG_THERMAL_FAN_OVERRIDE_VALUE;
 		}
-	}
-
-	for (uint8_t idx = 0; idx < max_fan_dev; idx++) {
-		uint16_t rpm;
-
-		fan_read_rpm(idx, &rpm);
-		smc_update_fan_tach(idx, rpm);
+		fan_duty_cycle_change = 1;
 	}
 
 	/* EC assumes OS is hung/BSOD occurred and takes override actions
@@ -276,15 +530,38 @@ static void manage_fan(void)
 		if ((cpu_temp > therm_bsod_override_acpi.temp_bsod_override) &&
 			(g_acpi_tbl.acpi_pwm_end_val <
 			therm_bsod_override_acpi.fan_bsod_override)) {
-			fan_set_duty_cycle(FAN_CPU,
-				therm_bsod_override_acpi.fan_bsod_override);
+			fan_duty_cycle[FAN_CPU] =
+				therm_bsod_override_acpi.fan_bsod_override;
+			fan_duty_cycle_change = 1;
 			therm_bsod_override_acpi.is_bsod_temp_crossed = true;
 		} else if ((cpu_temp < TEMP_BSOD_FAN_OFF) &&
 				therm_bsod_override_acpi.is_bsod_temp_crossed) {
-			fan_set_duty_cycle(FAN_CPU, 0);
+			fan_duty_cycle[FAN_CPU] = 0;
+			fan_duty_cycle_change = 1;
 			therm_bsod_override_acpi.is_bsod_temp_crossed = false;
 		}
 	}
+
+	/* Predicted critical temperature, run all fans at full speed */
+	if (therm_escalated_active()) {
+		for (uint8_t idx = 0; idx < max_fan_dev; idx++) {
+			fan_duty_cycle[idx] = FAN_MAX_DUTY;
+		}
+		fan_duty_cycle_change = 1;
+	}
+
+#ifdef CONFIG_THERMAL_FAN_PID
+	fan_duty_cycle_change = 0;
+	fan_ramp_duty(dt_ms);
+#else
+	if (fan_duty_cycle_change) {
+		fan_duty_cycle_change = 0;
+
+		for (uint8_t idx = 0; idx < max_fan_dev; idx++) {
+			fan_apply_duty(idx, fan_duty_cycle[idx]);
+		}
+	}
+#endif
 }
 
 static void manage_thermal_sensors(void)
@@ -326,6 +603,134 @@ void host_set_bios_bsod_override(uint8_t temp_bsod_override_val,
 	therm_bsod_override_acpi.fan_bsod_override = fan_bsod_override_val;
 }
 
+#ifdef CONFIG_THERMAL_PREDICTIVE_SHUTDOWN
+/* Move filtered value towards input by the weight of elapsed time */
+static int32_t therm_trend_filter(int32_t filtered, int32_t input,
+				  uint32_t delta_ms)
+{
+	int32_t num = (input - filtered) * (int32_t)delta_ms;
+	int32_t den = delta_ms + TREND_FILTER_TAU_MS;
+
+	return filtered + (num + (num < 0 ? -den / 2 : den / 2)) / den;
+}
+
+static void therm_trend_update(struct therm_trend *trend, int temp)
+{
+	uint32_t now = k_uptime_get_32();
+	int32_t fixed = temp << TREND_FRAC_BITS;
+	uint32_t delta_ms;
+	int32_t slope;
+
+	if (!trend->valid) {
+		trend->temp = fixed;
+		trend->slope = 0;
+		trend->timestamp = now;
+		trend->ref_temp = fixed;
+		trend->ref_time = now;
+		trend->valid = true;
+		return;
+	}
+
+	/* Weight saturates long before this, also bounds filter product */
+	delta_ms = MIN(now - trend->timestamp, 10 * TREND_FILTER_TAU_MS);
+	if (!delta_ms) {
+		return;
+	}
+
+	trend->temp = therm_trend_filter(trend->temp, fixed, delta_ms);
+	trend->timestamp = now;
+
+	delta_ms = now - trend->ref_time;
+	if (delta_ms < TREND_SLOPE_WINDOW_MS) {
+		return;
+	}
+
+	slope = (trend->temp - trend->ref_temp) * (int32_t)MSEC_PER_SEC /
+		(int32_t)delta_ms;
+	delta_ms = MIN(delta_ms, 10 * TREND_FILTER_TAU_MS);
+	trend->slope = therm_trend_filter(trend->slope, slope, delta_ms);
+	trend->ref_temp = trend->temp;
+	trend->ref_time = now;
+}
+
+/* Temperature expected at the end of prediction horizon */
+static int therm_trend_predict(const struct therm_trend *trend)
+{
+	int32_t rise = trend->slope *
+		       CONFIG_THERMAL_PREDICTIVE_HORIZON_MS / MSEC_PER_SEC;
+
+	/* Only rising trend is extrapolated */
+	return (trend->temp + MAX(rise, 0)) >> TREND_FRAC_BITS;
+}
+
+static void therm_escalate(bool enable)
+{
+	int ret;
+
+	if (enable == therm_escalated) {
+		return;
+	}
+
+	therm_escalated = enable;
+	LOG_WRN("Thermal escalation %s, cpu %d C", enable ? "on" : "off",
+		cpu_temp);
+
+	if (enable) {
+		/* Fans are not rate limited while escalated */
+		for (uint8_t idx = 0; idx < max_fan_dev; idx++) {
+			fan_duty_cycle[idx] = FAN_MAX_DUTY;
+			fan_apply_duty(idx, FAN_MAX_DUTY);
+		}
+
+		enqueue_sci(SCI_THERM_PREDICT);
+	}
+
+	ret = peci_update_pl4_offset(enable ?
+				     CONFIG_THERMAL_PREDICTIVE_PL4_OFFSET : 0);
+	if (ret) {
+		LOG_ERR("Failed to update PL4 offset %d", ret);
+	}
+}
+
+static void manage_predictive_shutdown(void)
+{
+	int predicted;
+	int release = g_acpi_tbl.acpi_crit_temp -
+		      CONFIG_THERMAL_PREDICTIVE_HYSTERESIS;
+
+	therm_trend_update(&cpu_trend, cpu_temp);
+	predicted = therm_trend_predict(&cpu_trend);
+
+	if (predicted >= g_acpi_tbl.acpi_crit_temp) {
+		LOG_WRN("CPU predicted %d C in %d ms", predicted,
+			CONFIG_THERMAL_PREDICTIVE_HORIZON_MS);
+		escalate_end = k_uptime_get_32() +
+			       CONFIG_THERMAL_PREDICTIVE_HOLD_MS;
+		therm_escalate(true);
+		return;
+	}
+
+	/* Release once trend is below hysteresis for hold time */
+	if (therm_escalated && predicted < release &&
+	    (int32_t)(k_uptime_get_32() - escalate_end) >= 0) {
+		therm_escalate(false);
+	}
+}
+
+static void therm_predict_reset(void)
+{
+	cpu_trend.valid = false;
+
+	/* PL4 offset is lost with CPU power. While PECI is unavailable in
+	 * S0, e.g. after PLTRST, keep escalation so offset is restored
+	 * through normal release once CPU can be accessed again.
+	 */
+	if (pwrseq_system_state() != SYSTEM_S0_STATE) {
+		therm_escalated = false;
+	}
+}
+#endif
+
 static void manage_cpu_thermal(void)
 {
 	int temp, ret, temp_change;
@@ -334,6 +739,9 @@ static void manage_cpu_thermal(void)
 	/* Manage CPU thermal only in S0 state */
 	if (!peci_initialized || k_timer_remaining_get(&peci_delay_timer) ||
 	    (pwrseq_system_state() != SYSTEM_S0_STATE)) {
+#ifdef CONFIG_THERMAL_PREDICTIVE_SHUTDOWN
+		therm_predict_reset();
+#endif
 		return;
 	}
 
@@ -357,6 +765,11 @@ static void manage_cpu_thermal(void)
 		return;
 	}
 
+#ifdef CONFIG_THERMAL_PREDICTIVE_SHUTDOWN
+	/* Throttle before critical temperature is actually reached */
+	manage_predictive_shutdown();
+#endif
+
 	/* Read GPU temperature using peci if the GPU is in an active state */
 	if ((gpio_read_pin(DG2_PRESENT) == HIGH) &&
 	    (gpio_read_pin(PEG_RTD3_COLD_MOD_SW_R) == HIGH)) {
@@ -421,6 +834,40 @@ static void manage_pch_temperature(void)
 	}
 }
 
+#ifdef CONFIG_THERMAL_ADAPTIVE_SAMPLING
+static void manage_sampling_rate(void)
+{
+	for (uint8_t src = 0; src < FAN_TEMP_SRC_TOTAL; src++) {
+		if (src >= FAN_TEMP_SRC_SEN1 &&
+		    therm_sensors[src - FAN_TEMP_SRC_SEN1] >= ADC_CH_TOTAL) {
+			continue;
+		}
+
+		therm_sched_update(src, therm_src_temp(src),
+				   g_acpi_tbl.acpi_crit_temp);
+	}
+}
+#endif
+
+#ifdef CONFIG_THERMAL_HISTORY
+static void manage_history(void)
+{
+	struct therm_hist_sample sample = { 0 };
+
+	for (uint8_t src = 0; src < FAN_TEMP_SRC_TOTAL; src++) {
+		sample.temp[src] = therm_src_temp(src);
+	}
+
+	for (uint8_t idx = 0; idx < max_fan_dev; idx++) {
+		sample.duty[idx] = fan_duty_applied[idx];
+		sample.rpm[idx] = fan_tach_rpm(idx);
+	}
+
+	sample.pwr_state = pwrseq_system_state();
+	therm_hist_record(&sample);
+}
+#endif
+
 void thermalmgmt_handle_cs_exit(void)
 {
 	LOG_DBG("CS Exit: Wake thermal thread from sleep");
@@ -445,6 +892,10 @@ void thermalmgmt_thread(void *p1, void *p2, void *p3)
 		peci_initialized = true;
 	}
 
+#ifdef CONFIG_THERMAL_ADAPTIVE_SAMPLING
+	therm_sched_init(normal_period);
+#endif
+
 	while (true) {
 		/* Each thread is aware of CS
 		 * Thread uses different sleep time during CS
@@ -452,11 +903,20 @@ void thermalmgmt_thread(void *p1, void *p2, void *p3)
 		 */
 		if (smchost_is_system_in_cs()) {
 			k_sleep(K_SECONDS(CPU_TEMP_CS_ACCESS_PERIOD_SEC));
+#ifdef CONFIG_THERMAL_ADAPTIVE_SAMPLING
+			/* History is stale after CS sleep */
+			therm_sched_reset();
+		} else if (pwrseq_system_state() == SYSTEM_S0_STATE) {
+			k_msleep(therm_sched_next_period());
+#endif
 		} else {
 			k_msleep(normal_period);
 		}
 
 		manage_fan();
+#ifdef CONFIG_THERMAL_HISTORY
+		manage_history();
+#endif
 
 		/* To achieve infinite C10 residency in connected standby
 		 * and ps_on, EC should not send peci cpu & pch temperature
@@ -470,6 +930,13 @@ void thermalmgmt_thread(void *p1, void *p2, void *p3)
 		manage_thermal_sensors();
 		manage_cpu_thermal();
 		manage_pch_temperature();
+#ifdef CONFIG_THERMAL_ADAPTIVE_SAMPLING
+		if (pwrseq_system_state() == SYSTEM_S0_STATE) {
+			manage_sampling_rate();
+		} else {
+			therm_sched_reset();
+		}
+#endif
 	}
 }
 
@@ -27,6 +27,20 @@ struct therm_bsod_override_thrsd_acpi {
 	bool is_bsod_temp_crossed;
 };
 
+/**
+ * @brief Fan runtime information reported to host.
+ */
+struct thermal_fan_info {
+	/* Last tach reading */
+	uint16_t rpm;
+	/* Duty cycle currently driven */
+	uint8_t duty;
+	/* Duty cycle requested by active control method */
+	uint8_t target_duty;
+	/* Temperature of fan zone in degree celsius */
+	uint8_t temp;
+};
+
 /* FAN override settings */
 #define FAN_OVERRIDE_ACPI		75u
 #define TEMP_OVERRIDE_ACPI		85u
@@ -103,6 +117,26 @@ void peci_start_delay_timer(void);
 void get_hw_peripherals_status(uint8_t *hw_peripherals_sts);
 
 
+/**
+ * @brief API to get current duty cycle driven for a fan device.
+ *
+ * @param idx fan device index.
+ *
+ * @retval duty cycle in percentage, 0 for invalid fan index.
+ */
+uint8_t thermalmgmt_get_fan_duty(enum fan_type idx);
+
+/**
+ * @brief API to get runtime information for a fan device.
+ *
+ * @param idx fan device index.
+ * @param info pointer where fan information is stored.
+ *
+ * @retval -EINVAL if fan is not present, otherwise 0.
+ */
+int thermalmgmt_get_fan_info(enum fan_type idx, struct thermal_fan_info *info);
+
+
 /**
  * @brief API for SMC host to notify the CS mode exit.
  *
@@ -0,0 +1,140 @@
+/*
+ * Copyright (c) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <errno.h>
+#include <zephyr.h>
+#include <logging/log.h>
+#include "acpi.h"
+#include "acpi_emul.h"
+
+LOG_MODULE_DECLARE(smchost, CONFIG_SMCHOST_LOG_LEVEL);
+
+#define ACPI_EMUL_PORTS		2
+
+/* RAM backed ACPI EC register model, same flag layout as EC_STS */
+struct acpi_emul_port {
+	uint8_t sts;
+	uint8_t idr;
+	uint8_t odr;
+	acpi_emul_handler_t handler;
+};
+
+static struct acpi_emul_port ports[ACPI_EMUL_PORTS];
+
+bool acpi_get_flag(enum acpi_ec_interface num, uint8_t type)
+{
+	return ports[num].sts & type;
+}
+
+void acpi_set_flag(enum acpi_ec_interface num, uint8_t type, bool val)
+{
+	unsigned int key = irq_lock();
+
+	if (val) {
+		ports[num].sts |= type;
+	} else {
+		ports[num].sts &= ~type;
+	}
+
+	irq_unlock(key);
+}
+
+uint8_t acpi_read_idr(enum acpi_ec_interface num)
+{
+	unsigned int key = irq_lock();
+	uint8_t byte = ports[num].idr;
+
+	/* Reading input data register clears IBF as in hardware */
+	ports[num].sts &= ~ACPI_FLAG_IBF;
+	irq_unlock(key);
+
+	return byte;
+}
+
+void acpi_write_odr(enum acpi_ec_interface num, uint8_t byte)
+{
+	unsigned int key = irq_lock();
+
+	ports[num].odr = byte;
+	ports[num].sts |= ACPI_FLAG_OBF;
+	irq_unlock(key);
+}
+
+uint8_t acpi_read_str(enum acpi_ec_interface num)
+{
+	return ports[num].sts;
+}
+
+int acpi_send_byte(enum acpi_ec_interface num, uint8_t data)
+{
+	for (uint16_t i = 0; i < HOST_TIMEOUT; i++) {
+		if (acpi_get_flag(num, ACPI_FLAG_OBF) == 1) {
+			continue;
+		}
+
+		acpi_write_odr(num, data);
+		return 0;
+	}
+
+	LOG_ERR("Host %d didn't consume the data %x. OBF always 1", num, data);
+	return -1;
+}
+
+void acpi_emul_set_handler(enum acpi_ec_interface num,
+			   acpi_emul_handler_t handler)
+{
+	ports[num].handler = handler;
+}
+
+int acpi_emul_host_write(enum acpi_ec_interface num, uint8_t byte, bool cmd)
+{
+	struct acpi_emul_port *port = &ports[num];
+	unsigned int key = irq_lock();
+
+	if (port->sts & ACPI_FLAG_IBF) {
+		irq_unlock(key);
+		return -EBUSY;
+	}
+
+	port->idr = byte;
+	port->sts |= ACPI_FLAG_IBF;
+	if (cmd) {
+		port->sts |= ACPI_FLAG_CD;
+	} else {
+		port->sts &= ~ACPI_FLAG_CD;
+	}
+
+	/* Deliver input buffer full interrupt in caller context */
+	if (port->handler) {
+		port->handler();
+	}
+
+	irq_unlock(key);
+
+	return 0;
+}
+
+int acpi_emul_host_read(enum acpi_ec_interface num, uint8_t *byte)
+{
+	struct acpi_emul_port *port = &ports[num];
+	unsigned int key = irq_lock();
+
+	if (!(port->sts & ACPI_FLAG_OBF)) {
+		irq_unlock(key);
+		return -EAGAIN;
+	}
+
+	*byte = port->odr;
+	port->sts &= ~ACPI_FLAG_OBF;
+	irq_unlock(key);
+
+	return 0;
+}
+
+uint8_t acpi_emul_host_status(enum acpi_ec_interface num)
+{
+	return ports[num].sts;
+}
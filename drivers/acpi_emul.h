@@ -0,0 +1,56 @@
+/*
+ * Copyright (c) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef __ACPI_EMUL_H__
+#define __ACPI_EMUL_H__
+
+#include "acpi.h"
+
+/**
+ * @brief Handler invoked when emulated host writes to ACPI EC interface.
+ */
+typedef void (*acpi_emul_handler_t)(void);
+
+/**
+ * @brief Register EC handler for emulated input buffer full interrupt.
+ *
+ * @param num ACPI EC interface.
+ * @param handler routine to invoke with interrupts locked.
+ */
+void acpi_emul_set_handler(enum acpi_ec_interface num,
+			   acpi_emul_handler_t handler);
+
+/**
+ * @brief Emulate host write to ACPI EC command or data port.
+ *
+ * @param num ACPI EC interface.
+ * @param byte the byte written by host.
+ * @param cmd true for command port, false for data port.
+ *
+ * @retval -EBUSY if EC did not consume previous byte, otherwise 0.
+ */
+int acpi_emul_host_write(enum acpi_ec_interface num, uint8_t byte, bool cmd);
+
+/**
+ * @brief Emulate host read from ACPI EC data port.
+ *
+ * @param num ACPI EC interface.
+ * @param byte pointer where the byte is stored.
+ *
+ * @retval -EAGAIN if output buffer is empty, otherwise 0.
+ */
+int acpi_emul_host_read(enum acpi_ec_interface num, uint8_t *byte);
+
+/**
+ * @brief Emulate host read from ACPI EC status port.
+ *
+ * @param num ACPI EC interface.
+ *
+ * @retval status register value.
+ */
+uint8_t acpi_emul_host_status(enum acpi_ec_interface num);
+
+#endif /* __ACPI_EMUL_H__ */
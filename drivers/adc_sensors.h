@@ -7,6 +7,8 @@
 #ifndef __ADC_SENSORS_H__
 #define __ADC_SENSORS_H__
 
+#include "thermistor.h"
+
 enum adc_ch_num {
 	ADC_CH_00,
 	ADC_CH_01,
@@ -23,6 +25,19 @@ enum adc_ch_num {
 
 extern int16_t adc_temp_val[ADC_CH_TOTAL];
 
+/**
+ * @brief Select thermistor part connected to an ADC channel.
+ *
+ * Channels default to NCP15WB473, boards using other parts call this
+ * before thermal sensor module is initialized.
+ *
+ * @param ch adc channel.
+ * @param type thermistor part.
+ *
+ * @return 0 if success, -EINVAL for invalid channel or part.
+ */
+int adc_sensors_set_thermistor(uint8_t ch, enum thermistor_type type);
+
 /**
  * @brief Initialize thermal sensor module.
  *
@@ -38,6 +53,9 @@ int adc_sensors_init(uint8_t adc_channel_bits);
  *
  * This function call reads all ADC thermal sensors enabled in init, and
  * updates adc_temp_val array for respective ADC channel reads.
+ *
+ * When background sampling is enabled, adc_temp_val array is updated
+ * with median filtered values periodically and this call does not block.
  */
 void adc_sensors_read_all(void);
 
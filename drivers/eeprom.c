@@ -33,15 +33,45 @@ LOG_MODULE_REGISTER(eeprom, CONFIG_EEPROM_LOG_LEVEL);
  * i.e. offset 0x0106 correspond to device address 0x51, offset 0x00
  */
 
+/* Serialize access from different tasks, the device NAKs any transfer
+ * during its internal write cycle.
+ */
+K_MUTEX_DEFINE(eeprom_lock);
+
+static int eeprom_i2c_read(uint16_t addr, uint8_t *wbuf, uint8_t wlen,
+			   uint8_t *rbuf, uint8_t rlen)
+{
+	int ret;
+
+	k_mutex_lock(&eeprom_lock, K_FOREVER);
+	ret = i2c_hub_write_read(I2C_0, addr, wbuf, wlen, rbuf, rlen);
+	k_mutex_unlock(&eeprom_lock);
+
+	return ret;
+}
+
+static int eeprom_i2c_write(uint8_t *buf, uint8_t len, uint16_t addr)
+{
+	int ret;
+
+	k_mutex_lock(&eeprom_lock, K_FOREVER);
+	ret = i2c_hub_write(I2C_0, buf, len, addr);
+	if (!ret) {
+		/* Delay to wait for write completion */
+		k_msleep(EEPROM_WR_MSDELAY);
+	}
+	k_mutex_unlock(&eeprom_lock);
+
+	return ret;
+}
+
 int eeprom_read_byte(uint16_t offset, uint8_t *data)
 {
 	uint8_t ret;
-	uint8_t buf = OFS_MSB(offset);
+	uint8_t buf = OFS_LSB(offset);
 
-	ret = i2c_hub_write_read(I2C_0,
-			     EEPROM_DRIVER_I2C_ADDR | OFS_MSB(offset),
-			     &buf, sizeof(buf),
-			     data, 1);
+	ret = eeprom_i2c_read(EEPROM_DRIVER_I2C_ADDR | OFS_MSB(offset),
+			      &buf, sizeof(buf), data, 1);
 	if (ret) {
 		LOG_ERR("Fail to read: %d", ret);
 		return ret;
@@ -55,15 +85,13 @@ int eeprom_write_byte(uint16_t offset, uint8_t data)
 	uint8_t ret;
 	uint8_t buf[] = { OFS_LSB(offset), data };
 
-	ret = i2c_hub_write(I2C_0, buf, sizeof(buf),
-			EEPROM_DRIVER_I2C_ADDR | OFS_MSB(offset));
+	ret = eeprom_i2c_write(buf, sizeof(buf),
+			       EEPROM_DRIVER_I2C_ADDR | OFS_MSB(offset));
 	if (ret) {
 		LOG_ERR("Fail to write: %d", ret);
 		return ret;
 	}
 
-	k_msleep(EEPROM_WR_MSDELAY);
-
 	return 0;
 }
 
@@ -73,10 +101,8 @@ int eeprom_read_word(uint16_t offset, uint16_t *data)
 	uint8_t buf = { OFS_LSB(offset) };
 	uint8_t rbuf[] = {EEPROM_DEFAULT_DATA, EEPROM_DEFAULT_DATA};
 
-	ret = i2c_hub_write_read(I2C_0,
-			     EEPROM_DRIVER_I2C_ADDR | OFS_MSB(offset),
-			     &buf, sizeof(buf),
-			     rbuf, sizeof(rbuf));
+	ret = eeprom_i2c_read(EEPROM_DRIVER_I2C_ADDR | OFS_MSB(offset),
+			      &buf, sizeof(buf), rbuf, sizeof(rbuf));
 	if (ret) {
 		LOG_ERR("Fail to read: %d", ret);
 		return ret;
@@ -94,16 +120,13 @@ int eeprom_write_word(uint16_t offset, uint16_t data)
 	uint8_t buf[] = { OFS_LSB(offset),
 		       OFS_MSB(data), OFS_LSB(data) };
 
-	ret = i2c_hub_write(I2C_0, buf, sizeof(buf),
-			EEPROM_DRIVER_I2C_ADDR | OFS_MSB(offset));
+	ret = eeprom_i2c_write(buf, sizeof(buf),
+			       EEPROM_DRIVER_I2C_ADDR | OFS_MSB(offset));
 	if (ret) {
 		LOG_ERR("Fail to write: %d", ret);
 		return ret;
 	}
 
-	/* Delay to wait for write completion */
-	k_msleep(EEPROM_WR_MSDELAY);
-
 	return 0;
 }
 
@@ -116,10 +139,8 @@ int eeprom_read_block(uint16_t offset, uint8_t len, uint8_t *data)
 		return -EINVAL;
 	}
 
-	ret = i2c_hub_write_read(I2C_0,
-			     EEPROM_DRIVER_I2C_ADDR | OFS_MSB(offset),
-			     &buf, sizeof(buf),
-			     data, len);
+	ret = eeprom_i2c_read(EEPROM_DRIVER_I2C_ADDR | OFS_MSB(offset),
+			      &buf, sizeof(buf), data, len);
 	if (ret) {
 		LOG_ERR("Fail to read: %d", ret);
 		return -EIO;
@@ -131,7 +152,10 @@ int eeprom_read_block(uint16_t offset, uint8_t len, uint8_t *data)
 int eeprom_write_block(uint16_t offset, uint8_t len, uint8_t *data)
 {
 	int ret;
-	uint8_t buf[DATA_MAX_LEN + sizeof(offset)];
+	/* Word address byte followed by data, A10..A8 are part of the
+	 * device address.
+	 */
+	uint8_t buf[DATA_MAX_LEN + 1];
 
 	if (len > DATA_MAX_LEN) {
 		return -EINVAL;
@@ -145,14 +169,12 @@ int eeprom_write_block(uint16_t offset, uint8_t len, uint8_t *data)
 		return ret;
 	}
 
-	ret = i2c_hub_write(I2C_0, buf, len + sizeof(offset),
-			EEPROM_DRIVER_I2C_ADDR | OFS_MSB(offset));
+	ret = eeprom_i2c_write(buf, len + 1,
+			       EEPROM_DRIVER_I2C_ADDR | OFS_MSB(offset));
 	if (ret) {
 		LOG_ERR("Fail to write: %d", ret);
 		return ret;
 	}
 
-	k_msleep(EEPROM_WR_MSDELAY);
-
 	return ret;
 }
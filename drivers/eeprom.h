@@ -12,6 +12,9 @@
 #ifndef __EEPROM_H__
 #define __EEPROM_H__
 
+/* Addressable EEPROM size, offset bits A10..A8 select the device address */
+#define EEPROM_SIZE		0x800U
+
 /**
  * @brief Read a byte from a EEPROM offset.
  *
@@ -10,6 +10,9 @@
 #include "pwrseq_utils.h"
 #include "board_config.h"
 #include "espioob_mngr.h"
+#ifdef CONFIG_ACPI_EC_EMUL
+#include "acpi_emul.h"
+#endif
 
 LOG_MODULE_REGISTER(espihub, CONFIG_ESPIHUB_LOG_LEVEL);
 
@@ -64,6 +67,11 @@ int espihub_add_acpi_handler(enum espihub_acpi_handler type,
 	}
 
 	acpi_handlers[type] = handler;
+#ifdef CONFIG_ACPI_EC_EMUL
+	if (type == ESPIHUB_ACPI_PUBLIC) {
+		acpi_emul_set_handler(ACPI_EC_0, handler);
+	}
+#endif
 	return 0;
 }
 
@@ -232,6 +240,7 @@ static void vwire_handler(const struct device *dev, struct espi_callback *cb,
 		case ESPI_VWIRE_SIGNAL_SLP_S3:
 		case ESPI_VWIRE_SIGNAL_SLP_S4:
 		case ESPI_VWIRE_SIGNAL_SLP_S5:
+		case ESPI_VWIRE_SIGNAL_SLP_A:
 			LOG_INF("SLP %d changed %d", event.evt_details,
 				event.evt_data);
 			if (state_handler) {
@@ -164,7 +164,8 @@ int wait_for_pin_monitor_vwire(uint32_t port_pin, uint32_t exp_sts,
 /**
  * @brief Add a system state handler.
  * States are tracked via eSPI host virtual wire notifications for each
- * system transition.
+ * system transition. SLP_A changes are also notified, although they do not
+ * indicate a system transition.
  *
  * @param handler module handler called when system state is received.
  *
@@ -27,6 +27,11 @@ struct oob_msg {
 	struct espi_oob_packet *rx;
 	struct k_mutex txn_lock;
 	struct k_sem txn_sync;
+	struct oob_stats stats;
+	/* Accumulated round-trip time used to derive the average */
+	uint64_t rtt_total_us;
+	/* Last sync request timed out, response may still show up */
+	bool rsp_overdue;
 };
 
 static struct oob_msg master_hw;
@@ -132,11 +137,8 @@ static int verify_oob_rx_pckt(struct espi_oob_packet *rx)
 	return 0;
 }
 
-static inline struct oob_msg *get_oob_master(uint8_t addr_byte)
+static inline struct oob_msg *get_oob_master_by_addr(uint8_t master_addr)
 {
-	/* Decode 7bit master address from 8bit address value */
-	uint8_t master_addr = OOB_7BIT_ADDR(addr_byte);
-
 	switch (master_addr) {
 	case OOB_MASTER_ADDR_HW:
 		return &master_hw;
@@ -149,12 +151,66 @@ static inline struct oob_msg *get_oob_master(uint8_t addr_byte)
 	}
 }
 
+static inline struct oob_msg *get_oob_master(uint8_t addr_byte)
+{
+	/* Decode 7bit master address from 8bit address value */
+	return get_oob_master_by_addr(OOB_7BIT_ADDR(addr_byte));
+}
+
+static void oob_update_rtt(struct oob_msg *master, uint32_t start_cyc)
+{
+	uint32_t rtt_us = k_cyc_to_us_floor32(k_cycle_get_32() - start_cyc);
+
+	master->rtt_total_us += rtt_us;
+	master->stats.max_rtt_us = MAX(master->stats.max_rtt_us, rtt_us);
+	if (master->stats.rx) {
+		master->stats.avg_rtt_us = (uint32_t)(master->rtt_total_us /
+						      master->stats.rx);
+	}
+}
+
+int oob_get_stats(uint8_t master_addr, struct oob_stats *stats)
+{
+	struct oob_msg *master;
+	unsigned int key;
+
+	if (stats == NULL) {
+		return -ENODATA;
+	}
+
+	master = get_oob_master_by_addr(master_addr);
+	if (master == NULL) {
+		return -EINVAL;
+	}
+
+	/* Counters are also updated from OOB rx ISR */
+	key = irq_lock();
+	*stats = master->stats;
+	irq_unlock(key);
+
+	return 0;
+}
+
+void oob_reset_stats(void)
+{
+	struct oob_msg *masters[] = { &master_hw, &master_pmc, &master_csme };
+	unsigned int key;
+
+	key = irq_lock();
+	for (int i = 0; i < ARRAY_SIZE(masters); i++) {
+		memsets(&masters[i]->stats, 0, sizeof(masters[i]->stats));
+		masters[i]->rtt_total_us = 0;
+	}
+	irq_unlock(key);
+}
+
 
 int oob_send_sync(struct espi_oob_packet *req, struct espi_oob_packet *resp,
 		  int timeout)
 {
 	int ret = 0;
 	struct oob_msg *master;
+	uint32_t start_cyc;
 	int wait_time = MAX(MIN(timeout, MAX_WAIT_TIME_FOR_OOB_IN_MS),
 		MIN_WAIT_TIME_FOR_OOB_IN_MS);
 
@@ -187,15 +243,20 @@ int oob_send_sync(struct espi_oob_packet *req, struct espi_oob_packet *resp,
 	master->tx = req;
 	master->rx = resp;
 	k_sem_reset(&master->txn_sync);
+	master->rsp_overdue = false;
 
+	start_cyc = k_cycle_get_32();
 	ret = espihub_send_oob(master->tx);
 	if (ret) {
 		LOG_ERR("Error sending OOB %d", ret);
+		master->stats.tx_err++;
 		k_mutex_unlock(&master->txn_lock);
 		k_sem_give(&master->txn_sync);
 		return -EIO;
 	}
 
+	master->stats.tx++;
+	master->stats.tx_bytes += req->len;
 	LOG_DBG("OOB Tx Successful");
 
 	/* Wait till OOB response, txn_sync semaphore released by rx handler */
@@ -203,10 +264,13 @@ int oob_send_sync(struct espi_oob_packet *req, struct espi_oob_packet *resp,
 
 	if (ret) {
 		LOG_ERR("OOB Rx sem timeout");
+		master->stats.timeouts++;
+		master->rsp_overdue = true;
 		ret = -ETIMEDOUT;
 	} else {
 		if (master->rx->len) {
 			LOG_DBG("OOB Rx Successful");
+			oob_update_rtt(master, start_cyc);
 		} else {
 			LOG_ERR("OOB Rx received, but buffer space not enough");
 			ret = -ENOBUFS;
@@ -289,8 +353,11 @@ int oob_respond_master(struct espi_oob_packet *tx)
 	ret = espihub_send_oob(master->tx);
 	if (ret) {
 		LOG_ERR("Error sending OOB %d", ret);
+		master->stats.tx_err++;
 		ret = -EIO;
 	} else {
+		master->stats.tx++;
+		master->stats.tx_bytes += tx->len;
 		LOG_DBG("OOB Tx Successful");
 	}
 
@@ -335,6 +402,8 @@ static void oob_rx_handler(struct espi_oob_packet *rx)
 	 * tied as a response to the EC initiated OOB request message. Semaphore
 	 * must be released then for the waiting task to catch the response.
 	 */
+	master->stats.rx_bytes += rx->len;
+
 	if (k_sem_count_get(&master->txn_sync)) {
 		/*
 		 * This is where CSME incoming messages can be handled
@@ -343,6 +412,12 @@ static void oob_rx_handler(struct espi_oob_packet *rx)
 		 * No action needed, they can be discarded. Warning log is
 		 * enough. When that happens, MIN_WAIT_TIME should be tweaked.
 		 */
+		if (master->rsp_overdue) {
+			master->rsp_overdue = false;
+			master->stats.late_rsp++;
+		} else {
+			master->stats.unsolicited++;
+		}
 
 		if (rx->len < sizeof(msg.buf)) {
 			memcpys(msg.buf, rx->buf, rx->len);
@@ -362,8 +437,10 @@ static void oob_rx_handler(struct espi_oob_packet *rx)
 		if (master->rx->len >= rx->len) {
 			memcpys(master->rx->buf, rx->buf, rx->len);
 			master->rx->len = rx->len;
+			master->stats.rx++;
 		} else {
 			master->rx->len = 0;
+			master->stats.rx_nobufs++;
 			LOG_WRN("Rx Buf space too small");
 		}
 
@@ -78,6 +78,26 @@ struct oob_msg_str {
 
 #define OOB_MSG_SYNC_WAIT_TIME_DFLT	1000U
 
+/**
+ * @brief Per-master OOB channel statistics.
+ *
+ * Round-trip time is measured from the request being sent to the response
+ * being consumed by the waiting thread.
+ */
+struct oob_stats {
+	uint32_t tx;
+	uint32_t tx_err;
+	uint32_t rx;
+	uint32_t rx_nobufs;
+	uint32_t timeouts;
+	uint32_t late_rsp;
+	uint32_t unsolicited;
+	uint32_t tx_bytes;
+	uint32_t rx_bytes;
+	uint32_t max_rtt_us;
+	uint32_t avg_rtt_us;
+};
+
 /**
  * @brief Routine that handles eSPI OOB transactions.
  *
@@ -199,4 +219,19 @@ void oob_rx_cb_handler(void);
  */
 void register_oob_hndlr(uint8_t master_addr, oob_rx_callback_handler_t fn);
 
+/**
+ * @brief Get OOB channel statistics for a master.
+ *
+ * @param master_addr OOB master 7-bit address : HW, CSME, PMC.
+ * @param stats pointer where the statistics snapshot is copied.
+ *
+ * @return 0 if successful, -EINVAL for unknown master, -ENODATA if null.
+ */
+int oob_get_stats(uint8_t master_addr, struct oob_stats *stats);
+
+/**
+ * @brief Clear OOB channel statistics for all masters.
+ */
+void oob_reset_stats(void);
+
 #endif /* __ESPIOOB_MNGR_H_ */
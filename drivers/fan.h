@@ -39,9 +39,41 @@ enum fan_type {
 	FAN_DEV_UNDEF = 0xFF,
 };
 
+/**
+ * @brief Temperature source driving a fan in EC self control.
+ */
+enum fan_temp_src {
+	FAN_TEMP_SRC_CPU,
+	FAN_TEMP_SRC_GPU,
+	FAN_TEMP_SRC_PCH,
+	/* ACPI thermal sensors 1 to 5 */
+	FAN_TEMP_SRC_SEN1,
+	FAN_TEMP_SRC_SEN2,
+	FAN_TEMP_SRC_SEN3,
+	FAN_TEMP_SRC_SEN4,
+	FAN_TEMP_SRC_SEN5,
+	FAN_TEMP_SRC_TOTAL,
+};
+
+/**
+ * @brief Fan cooling zone used when EC controls the fan.
+ *
+ * Duty cycle follows a linear curve from duty_min at temp_min up to 100% at
+ * temp_max. A zero temp_max selects the default CPU fan profile. With closed
+ * loop control target_temp is tracked instead, 0 selects the build default.
+ */
+struct fan_zone {
+	enum fan_temp_src temp_src;
+	uint8_t temp_min;
+	uint8_t temp_max;
+	uint8_t duty_min;
+	uint8_t target_temp;
+};
+
 struct fan_dev {
 	enum pwm_ch_num pwm_ch;
 	enum tach_ch_num tach_ch;
+	struct fan_zone zone;
 };
 
 /**
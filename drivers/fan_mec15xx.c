@@ -42,7 +42,7 @@ LOG_MODULE_REGISTER(fan, CONFIG_FAN_LOG_LEVEL);
 static const struct device *pwm_dev[PWM_DEV_LIST_SIZE];
 static const struct device *tach_dev[TACH_DEV_LIST_SIZE];
 
-static struct fan_dev fan_table[] = {
+static struct fan_dev fan_table[FAN_DEV_TOTAL] = {
 	{ PWM_CH_00,	TACH_CH_00	},
 	{ PWM_CH_UNDEF,	TACH_CH_UNDEF	},
 	{ PWM_CH_UNDEF,	TACH_CH_UNDEF	},
@@ -117,8 +117,7 @@ int fan_init(int size, struct fan_dev *fan_tbl)
 			return -ENODEV;
 		}
 
-		fan_table[idx].pwm_ch = fan_tbl[idx].pwm_ch;
-		fan_table[idx].tach_ch = fan_tbl[idx].tach_ch;
+		fan_table[idx] = fan_tbl[idx];
 	}
 
 	return 0;
@@ -134,7 +133,7 @@ int fan_set_duty_cycle(enum fan_type fan_idx, uint8_t duty_cycle)
 {
 	int ret;
 
-	if (fan_idx > ARRAY_SIZE(fan_table)) {
+	if (fan_idx >= ARRAY_SIZE(fan_table)) {
 		return -ENOTSUP;
 	}
 
@@ -168,7 +167,7 @@ int fan_read_rpm(enum fan_type fan_idx, uint16_t *rpm)
 	int ret;
 	struct sensor_value val;
 
-	if (fan_idx > ARRAY_SIZE(fan_table)) {
+	if (fan_idx >= ARRAY_SIZE(fan_table)) {
 		return -ENOTSUP;
 	}
 
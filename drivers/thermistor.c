@@ -0,0 +1,47 @@
+/*
+ * Copyright (c) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr.h>
+#include <errno.h>
+#include "thermistor.h"
+
+/* Generated at build time, defines thermistor_tbls[] */
+#include "thermistor_tbl.h"
+
+#define THERMISTOR_TBL_STEP		BIT(THERMISTOR_TBL_SHIFT)
+
+BUILD_ASSERT(ARRAY_SIZE(thermistor_tbls) == THERMISTOR_TYPE_TOTAL,
+	     "Thermistor table missing for a part");
+
+uint8_t thermistor_adc_resolution(void)
+{
+	return THERMISTOR_ADC_RESOLUTION;
+}
+
+int thermistor_raw_to_temp(enum thermistor_type type, uint16_t raw,
+			   int16_t *temp)
+{
+	const struct thermistor_tbl *tbl;
+	uint16_t idx;
+	int32_t delta;
+
+	if (type >= THERMISTOR_TYPE_TOTAL) {
+		return -EINVAL;
+	}
+
+	tbl = &thermistor_tbls[type];
+	if (raw < tbl->raw_min || raw > tbl->raw_max) {
+		return -ERANGE;
+	}
+
+	idx = raw >> THERMISTOR_TBL_SHIFT;
+	delta = tbl->temp[idx + 1] - tbl->temp[idx];
+
+	*temp = tbl->temp[idx] +
+		delta * (raw & (THERMISTOR_TBL_STEP - 1)) / THERMISTOR_TBL_STEP;
+
+	return 0;
+}
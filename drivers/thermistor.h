@@ -0,0 +1,44 @@
+/*
+ * Copyright (c) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef __THERMISTOR_H__
+#define __THERMISTOR_H__
+
+/* Supported thermistor parts including board voltage divider.
+ * Conversion tables are generated by scripts/gen_thermistor_tbl.py.
+ */
+enum thermistor_type {
+	THERMISTOR_NCP15WB473,
+	THERMISTOR_NCP15XH103,
+	THERMISTOR_B57861S0103,
+
+	THERMISTOR_TYPE_TOTAL
+};
+
+/**
+ * @brief ADC resolution thermistor tables are generated for.
+ *
+ * @return resolution in bits.
+ */
+uint8_t thermistor_adc_resolution(void);
+
+/**
+ * @brief Convert thermistor ADC raw value to temperature.
+ *
+ * Conversion is done in constant time by indexing the part table with the
+ * raw value and interpolating between adjacent entries.
+ *
+ * @param type thermistor part connected to the ADC channel.
+ * @param raw ADC raw value.
+ * @param temp pointer to update temperature in 0.1 degree Celsius.
+ *
+ * @return 0 if success, -ERANGE if raw value is outside the characterized
+ * range of the part, -EINVAL for unknown part.
+ */
+int thermistor_raw_to_temp(enum thermistor_type type, uint16_t raw,
+			   int16_t *temp);
+
+#endif	/* __THERMISTOR_H__ */
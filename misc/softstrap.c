@@ -43,7 +43,7 @@ __in_section(softstrap, static, var) const struct softstrap_layout strp_reg = {
 			.timeout_config = 1,
 			.usbc_config = 0,
 			.charger_config = 0,
-			.dtt_config = 0,
+			.dtt_config = IS_ENABLED(CONFIG_THERMAL_ADAPTIVE_SAMPLING),
 			.debug = 0,
 			.security = 0,
 		}
@@ -67,6 +67,17 @@ __in_section(softstrap, static, var) const struct softstrap_layout strp_reg = {
 		.usbc_cfg = { {0} },
 		.chrg_cfg = { {0} },
 		.spi_cfg = {0},
+#ifdef CONFIG_THERMAL_ADAPTIVE_SAMPLING
+		.dtt_cfg = {
+			.therm_min_period = THERM_PERIOD_FROM_MS(
+				CONFIG_THERMAL_ADAPTIVE_MIN_PERIOD_MS),
+			.therm_max_period = THERM_MAX_PERIOD_FROM_MS(
+				CONFIG_THERMAL_ADAPTIVE_MAX_PERIOD_MS),
+			.therm_slope = CONFIG_THERMAL_ADAPTIVE_SLOPE,
+			.therm_crit_margin =
+				CONFIG_THERMAL_ADAPTIVE_CRIT_MARGIN,
+		},
+#endif
 	},
 };
 
@@ -9,7 +9,7 @@
 
 /* Sofstrap specification version implemented */
 #define SOFTSTRAP_MAJOR_VERSION    1
-#define SOFTSTRAP_MINOR_VERSION    0
+#define SOFTSTRAP_MINOR_VERSION    1
 
 /* Sofstrap timeout value are specified in 500 milliseconds units.
  * i.e. 1000 ms corresponds to value 0x02
@@ -117,8 +117,24 @@ struct spi_config {
 	uint32_t reserved;
 } __attribute__((__packed__));
 
+/* Thermal sampling minimum period in 10 ms units, maximum in 100 ms units */
+#define THERM_PERIOD_FROM_MS(x)       ((x) / 10)
+#define THERM_PERIOD_TO_MS(x)         ((x) * 10)
+#define THERM_MAX_PERIOD_FROM_MS(x)   ((x) / 100)
+#define THERM_MAX_PERIOD_TO_MS(x)     ((x) * 100)
+
+/**
+ * @brief Adaptive thermal sampling limits, 0 selects firmware default.
+ */
 struct dtt_config {
-	uint32_t reserved;
+	uint8_t therm_min_period;
+	uint8_t therm_max_period;
+	/* Temperature rise rate in 0.1 deg C/s requiring fastest sampling */
+	uint8_t therm_slope;
+	/* Distance to critical temperature in deg C requiring fastest
+	 * sampling
+	 */
+	uint8_t therm_crit_margin;
 } __attribute__((__packed__));
 
 struct dev_config {
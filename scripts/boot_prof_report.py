@@ -0,0 +1,232 @@
+#!/usr/bin/env python3
+#
+# Copyright (c) 2021 Intel Corporation
+#
+# SPDX-License-Identifier: Apache-2.0
+#
+"""Report S5/S3 to S0 boot profile recorded by EC firmware.
+
+Boot profile is read with SMC command 0x1C through ACPI EC interface,
+which requires root access to /dev/port on the host. Alternatively, the
+raw responses can be provided as a text file, one response per line as
+hex bytes, e.g. as captured by a UEFI shell tool.
+
+Report lists every power sequence event relative to the first one and
+highlights the latency added by EC firmware itself: fixed delays in the
+power on sequence, power sequencing task scheduling and signal polling.
+"""
+
+import argparse
+import os
+import struct
+import sys
+import time
+
+SMC_GET_BOOT_PROFILE = 0x1C
+
+RES_SIZE = 32
+RES_HDR_SIZE = 8
+RES_MARKS = (RES_SIZE - RES_HDR_SIZE) // 4
+NO_TS = 0xFFFFFFFF
+
+# ACPI EC status register flags
+EC_OBF = 0x01
+EC_IBF = 0x02
+EC_TIMEOUT_S = 1.0
+
+# Event names in same order as enum boot_prof_mark in boot_prof.h
+MARKS = [
+    'PWRBTN',
+    'SLP_S5',
+    'SLP_S4',
+    'SLP_S3',
+    'PWRSEQ_START',
+    'RSMRST_PWRGD',
+    'PM_RSMRST',
+    'SLP_A',
+    'ALL_SYS_PWRGD',
+    'PCH_PWROK',
+    'SYS_PWROK',
+    'PLTRST',
+    'PWRSEQ_END',
+    'PORT80',
+]
+
+TYPES = {0: 'none', 1: 'S5->S0', 2: 'S3->S0', 3: 'S3->S0 fast'}
+STATES = {0: 'idle', 1: 'in progress', 2: 'done', 3: 'failed'}
+
+# Signals EC waits for by polling, each may add up to one polling period
+POLLED = ['RSMRST_PWRGD', 'SLP_A', 'ALL_SYS_PWRGD', 'PLTRST']
+
+
+class AcpiEc:
+    """Minimal ACPI EC command interface via /dev/port."""
+
+    def __init__(self, dev, cmd_port, data_port):
+        self.fd = os.open(dev, os.O_RDWR)
+        self.cmd_port = cmd_port
+        self.data_port = data_port
+
+    def close(self):
+        os.close(self.fd)
+
+    def _inb(self, port):
+        os.lseek(self.fd, port, os.SEEK_SET)
+        return os.read(self.fd, 1)[0]
+
+    def _outb(self, port, val):
+        os.lseek(self.fd, port, os.SEEK_SET)
+        os.write(self.fd, bytes([val]))
+
+    def _wait(self, mask, val):
+        end = time.monotonic() + EC_TIMEOUT_S
+        while (self._inb(self.cmd_port) & mask) != val:
+            if time.monotonic() > end:
+                raise TimeoutError('EC not responding')
+
+    def command(self, cmd, data, res_len):
+        self._wait(EC_IBF, 0)
+        self._outb(self.cmd_port, cmd)
+        for byte in data:
+            self._wait(EC_IBF, 0)
+            self._outb(self.data_port, byte)
+
+        res = bytearray()
+        for _ in range(res_len):
+            self._wait(EC_OBF, EC_OBF)
+            res.append(self._inb(self.data_port))
+
+        return bytes(res)
+
+
+def read_chunks_ec(args):
+    ec = AcpiEc(args.dev, args.cmd_port, args.data_port)
+    try:
+        chunks = [ec.command(SMC_GET_BOOT_PROFILE, [0], RES_SIZE)]
+        num_marks = chunks[0][6]
+        for idx in range(1, (num_marks + RES_MARKS - 1) // RES_MARKS):
+            chunks.append(ec.command(SMC_GET_BOOT_PROFILE, [idx], RES_SIZE))
+    finally:
+        ec.close()
+
+    return chunks
+
+
+def read_chunks_file(path):
+    chunks = []
+    with open(path) as f:
+        for line in f:
+            line = line.strip()
+            if line and not line.startswith('#'):
+                chunks.append(bytes(int(b, 16) for b in line.split()))
+
+    return chunks
+
+
+def parse(chunks):
+    for chunk in chunks:
+        if len(chunk) < RES_SIZE:
+            sys.exit('Invalid response length %d' % len(chunk))
+
+    hdr = chunks[0]
+    prof = {
+        'type': TYPES.get(hdr[0], str(hdr[0])),
+        'state': STATES.get(hdr[1], str(hdr[1])),
+        'count': struct.unpack_from('<H', hdr, 2)[0],
+        'poll_us': struct.unpack_from('<H', hdr, 4)[0],
+        'ts': {},
+    }
+
+    num_marks = hdr[6]
+    for chunk in chunks:
+        first = chunk[7]
+        values = struct.unpack_from('<%dI' % RES_MARKS, chunk, RES_HDR_SIZE)
+        for i, value in enumerate(values):
+            idx = first + i
+            if idx < num_marks and value != NO_TS:
+                name = MARKS[idx] if idx < len(MARKS) else 'EVT%d' % idx
+                prof['ts'][name] = value
+
+    return prof
+
+
+def delta(ts, start, end):
+    if start in ts and end in ts:
+        return ts[end] - ts[start]
+
+    return None
+
+
+def fmt_ms(us):
+    return '%10.3f ms' % (us / 1000.0) if us is not None else '%13s' % '-'
+
+
+def report(prof):
+    ts = prof['ts']
+
+    print('Boot profile #%d: %s, %s' % (prof['count'], prof['type'],
+                                         prof['state']))
+    print()
+    print('%-14s %13s %13s' % ('Event', 'Time', 'Delta'))
+
+    prev = None
+    for name, value in sorted(ts.items(), key=lambda item: item[1]):
+        print('%-14s %s %s' % (name, fmt_ms(value),
+                               fmt_ms(value - prev if prev is not None
+                                      else None)))
+        prev = value
+
+    slp = [ts[s] for s in ('SLP_S5', 'SLP_S4', 'SLP_S3') if s in ts]
+    task = (ts['PWRSEQ_START'] - max(slp)
+            if slp and 'PWRSEQ_START' in ts else None)
+    polled = [s for s in POLLED if s in ts]
+
+    print()
+    print('EC added latency')
+    print('  %-40s %s' % ('Power sequencing task scheduling',
+                          fmt_ms(task)))
+    print('  %-40s %s' % ('VR ramp delay (ALL_SYS_PWRGD->PCH)',
+                          fmt_ms(delta(ts, 'ALL_SYS_PWRGD', 'PCH_PWROK'))))
+    print('  %-40s %s' % ('T36 delay (PCH_PWROK->SYS_PWROK)',
+                          fmt_ms(delta(ts, 'PCH_PWROK', 'SYS_PWROK'))))
+    print('  %-40s %s' % ('Signal polling, worst case (%d x %d us)' %
+                          (len(polled), prof['poll_us']),
+                          fmt_ms(len(polled) * prof['poll_us'])))
+    print()
+    print('  %-40s %s' % ('Power on sequence',
+                          fmt_ms(delta(ts, 'PWRSEQ_START', 'PWRSEQ_END'))))
+    if prof['type'].startswith('S3'):
+        print('  %-40s %s' % ('S3 exit (SLP_S3->PWRSEQ_END)',
+                              fmt_ms(delta(ts, 'SLP_S3', 'PWRSEQ_END'))))
+    if ts:
+        print('  %-40s %s' % ('First event to first postcode',
+                              fmt_ms(ts['PORT80'] - min(ts.values())
+                                     if 'PORT80' in ts else None)))
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description=__doc__, formatter_class=argparse.RawTextHelpFormatter)
+    parser.add_argument('-i', '--input',
+                        help='file with raw SMC responses instead of EC')
+    parser.add_argument('--dev', default='/dev/port',
+                        help='I/O port device')
+    parser.add_argument('--cmd-port', type=lambda x: int(x, 0),
+                        default=0x66, help='ACPI EC command/status port')
+    parser.add_argument('--data-port', type=lambda x: int(x, 0),
+                        default=0x62, help='ACPI EC data port')
+    args = parser.parse_args()
+
+    if args.input:
+        chunks = read_chunks_file(args.input)
+    else:
+        chunks = read_chunks_ec(args)
+
+    if not chunks:
+        sys.exit('No boot profile data')
+
+    report(parse(chunks))
+
+
+if __name__ == '__main__':
+    main()
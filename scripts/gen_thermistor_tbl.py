@@ -0,0 +1,184 @@
+#!/usr/bin/env python3
+#
+# Copyright (c) 2021 Intel Corporation
+#
+# SPDX-License-Identifier: Apache-2.0
+#
+"""Generate thermistor conversion tables for ADC thermal sensors.
+
+Thermistor is connected as low side of a voltage divider with pull-up
+resistor to ADC reference voltage, so ADC code only depends on ratio:
+
+    code = 2^resolution * Rth / (Rp + Rth)
+
+For every supported part, temperature in 0.1 degree Celsius is computed
+at every 2^shift ADC codes. Firmware interpolates between two entries
+indexed directly by ADC code. Valid ADC code range of each part covers
+the temperature range the part is characterized for.
+"""
+
+import argparse
+import math
+import os
+
+KELVIN = 273.15
+# Tolerance on characterized range when selecting valid ADC codes
+RANGE_MARGIN = 0.5
+
+# Circuit and part parameters. Enumeration name must be defined in
+# drivers/thermistor.h in the same order.
+PARTS = [
+    # Single B25/50 beta reads up to 3.6 C high near 120 C for this part.
+    # Coefficients are a least squares Steinhart-Hart fit to the datasheet
+    # derived table previously used by adc_sensors.c (-40 C to 125 C every
+    # 0.5 C). Fit is within 0.2 C of that table from 0 C to 85 C and within
+    # 0.6 C elsewhere, implied B25/85 is 4113 K against 4108 K in datasheet.
+    {
+        'enum': 'THERMISTOR_NCP15WB473',
+        'desc': 'Murata NCP15WB473F03RC 47k Steinhart-Hart, 22.6k pull-up',
+        'model': 'sh',
+        'a': 8.795110457e-4, 'b': 2.206633894e-4, 'c': 8.083690548e-8,
+        'rp': 22600.0,
+        'tmin': -40.0, 'tmax': 125.0,
+    },
+    {
+        'enum': 'THERMISTOR_NCP15XH103',
+        'desc': 'Murata NCP15XH103F03RC 10k B3380, 10k pull-up',
+        'model': 'beta',
+        'r0': 10000.0, 't0': 25.0, 'beta': 3380.0,
+        'rp': 10000.0,
+        'tmin': -40.0, 'tmax': 125.0,
+    },
+    {
+        'enum': 'THERMISTOR_B57861S0103',
+        'desc': 'TDK B57861S0103 10k Steinhart-Hart, 10k pull-up',
+        'model': 'sh',
+        'a': 1.125181376e-3, 'b': 2.347420615e-4, 'c': 8.536765271e-8,
+        'rp': 10000.0,
+        'tmin': -40.0, 'tmax': 125.0,
+    },
+]
+
+
+def temp_from_res(part, res):
+    """Return temperature in degree Celsius for thermistor resistance."""
+    if part['model'] == 'beta':
+        inv = (1.0 / (part['t0'] + KELVIN) +
+               math.log(res / part['r0']) / part['beta'])
+    else:
+        lnr = math.log(res)
+        inv = part['a'] + part['b'] * lnr + part['c'] * lnr ** 3
+
+    return 1.0 / inv - KELVIN
+
+
+def temp_from_code(part, code, full_scale):
+    """Return temperature for ADC code, None if it cannot be computed."""
+    if code <= 0 or code >= full_scale:
+        return None
+
+    ratio = code / full_scale
+    return temp_from_res(part, part['rp'] * ratio / (1.0 - ratio))
+
+
+def deci(temp):
+    return int(max(-32767, min(32767, round(temp * 10))))
+
+
+def gen_part(part, resolution, shift):
+    full_scale = 1 << resolution
+    step = 1 << shift
+    entries = []
+
+    for code in range(0, full_scale + 1, step):
+        temp = temp_from_code(part, code, full_scale)
+        if temp is None:
+            # Open circuit or short, clamp to characterized range
+            temp = part['tmax'] if code == 0 else part['tmin']
+        entries.append(deci(temp))
+
+    # NTC, temperature decreases as code increases. Codes within half a
+    # degree of characterized range are kept, so range ends are reachable.
+    valid = [code for code in range(1, full_scale)
+             if part['tmin'] - RANGE_MARGIN <=
+             temp_from_code(part, code, full_scale) <=
+             part['tmax'] + RANGE_MARGIN]
+    raw_min, raw_max = valid[0], valid[-1]
+
+    max_err = 0
+    for code in range(raw_min, raw_max + 1):
+        idx, frac = code >> shift, code & (step - 1)
+        interp = entries[idx] + int((entries[idx + 1] - entries[idx]) *
+                                    frac / step)
+        exact = deci(temp_from_code(part, code, full_scale))
+        max_err = max(max_err, abs(interp - exact))
+
+    return raw_min, raw_max, entries, max_err
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__)
+    parser.add_argument('-o', '--output', required=True,
+                        help='generated header file')
+    parser.add_argument('--resolution', type=int, default=10,
+                        help='ADC resolution in bits')
+    parser.add_argument('--shift', type=int, default=2,
+                        help='log2 of ADC codes between table entries')
+    args = parser.parse_args()
+
+    lines = [
+        '/* Generated by gen_thermistor_tbl.py, do not edit */',
+        '',
+        '#ifndef __THERMISTOR_TBL_H__',
+        '#define __THERMISTOR_TBL_H__',
+        '',
+        '#define THERMISTOR_ADC_RESOLUTION\t%d' % args.resolution,
+        '#define THERMISTOR_TBL_SHIFT\t\t%d' % args.shift,
+        '#define THERMISTOR_TBL_ENTRIES\t\t%d' %
+        (((1 << args.resolution) >> args.shift) + 1),
+        '',
+        'struct thermistor_tbl {',
+        '\t/* Characterized range of the part in ADC raw values */',
+        '\tuint16_t raw_min;',
+        '\tuint16_t raw_max;',
+        '\t/* Temperature in 0.1 deg C every 2^THERMISTOR_TBL_SHIFT codes */',
+        '\tint16_t temp[THERMISTOR_TBL_ENTRIES];',
+        '};',
+        '',
+        'static const struct thermistor_tbl thermistor_tbls[] = {',
+    ]
+
+    for part in PARTS:
+        raw_min, raw_max, entries, max_err = gen_part(part, args.resolution,
+                                                      args.shift)
+        lines.append('\t/* %s, max interpolation error against model '
+                     '%d.%d C */' % (part['desc'], max_err // 10,
+                                     max_err % 10))
+        lines.append('\t[%s] = {' % part['enum'])
+        lines.append('\t\t.raw_min = %d,' % raw_min)
+        lines.append('\t\t.raw_max = %d,' % raw_max)
+        lines.append('\t\t.temp = {')
+        for i in range(0, len(entries), 8):
+            lines.append('\t\t\t' + ', '.join('%d' % e
+                                              for e in entries[i:i + 8]) +
+                         ',')
+        lines.append('\t\t},')
+        lines.append('\t},')
+
+    lines += [
+        '};',
+        '',
+        '#endif /* __THERMISTOR_TBL_H__ */',
+        '',
+    ]
+
+    out_dir = os.path.dirname(args.output)
+    if out_dir:
+        os.makedirs(out_dir, exist_ok=True)
+
+    with open(args.output, 'w') as out:
+        out.write('\n'.join(lines))
+
+
+if __name__ == '__main__':
+    main()